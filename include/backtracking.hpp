@@ -1,15 +1,35 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 
+#include "board.hpp"
 #include "constants.hpp"
+#include "solveTask.hpp"
+#include "solverStats.hpp"
+#include "solverTrace.hpp"
 
 namespace backtracking {
 
 bool isValid(int row, int col, int num, std::vector<std::vector<int>>& grid);
 
-bool solver(int row, int col, std::vector<std::vector<int>>& grid);
+// trace, if given, receives every placement and removal of the search
+void solve(std::vector<std::vector<int>>& grid, trace::Recorder* trace = nullptr);
 
-void solve(std::vector<std::vector<int>>& grid);
+// the same search as solve(), one step per digit tried
+std::unique_ptr<SolveTask> makeSolveTask(const std::vector<std::vector<int>>& grid);
+
+// ------------------------
+// Size-specialized engine, instantiated for every board in SUDOKUX_FOR_EACH_BOARD
+// ------------------------
+
+template <class B>
+bool isValid(const B& board, int row, int col, int num);
+
+template <class B>
+bool solver(B& board, int cell);
+
+template <class B>
+bool solve(B& board, trace::Recorder* trace = nullptr);
 
 }  // namespace backtracking
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "constants.hpp"
+
+// ------------------------
+// Compile-time board geometry: a size x size grid split into BOX_ROWS x BOX_COLS boxes.
+// Engines are templated on the board so every loop bound and box computation is a constant.
+// ------------------------
+
+template <int BOX_ROWS, int BOX_COLS>
+struct Board {
+    static constexpr int boxRows = BOX_ROWS;
+    static constexpr int boxCols = BOX_COLS;
+    static constexpr int size = BOX_ROWS * BOX_COLS;
+    static constexpr int cellCount = size * size;
+
+    // candidate / used-digit sets, bit d stands for digit d
+    using Mask = std::conditional_t<(size < 16), uint16_t, uint32_t>;
+    static constexpr Mask ALL_DIGITS = static_cast<Mask>(((1ULL << size) - 1) << 1);
+
+    std::array<uint8_t, cellCount> cells{};  // row-major, EMPTY for holes
+
+    static constexpr int rowOf(int cell) { return cell / size; }
+    static constexpr int colOf(int cell) { return cell % size; }
+    static constexpr int boxOf(int row, int col) { return (row / BOX_ROWS) * BOX_ROWS + col / BOX_COLS; }
+    static constexpr int boxOfCell(int cell) { return boxOf(rowOf(cell), colOf(cell)); }
+
+    uint8_t& at(int row, int col) { return cells[row * size + col]; }
+    uint8_t at(int row, int col) const { return cells[row * size + col]; }
+
+    static Board fromGrid(const std::vector<std::vector<int>>& grid) {
+        Board board;
+        for (int row = 0; row < size; row++) {
+            for (int col = 0; col < size; col++) board.at(row, col) = static_cast<uint8_t>(grid[row][col]);
+        }
+        return board;
+    }
+
+    void toGrid(std::vector<std::vector<int>>& grid) const {
+        grid.assign(size, std::vector<int>(size, EMPTY));
+        for (int row = 0; row < size; row++) {
+            for (int col = 0; col < size; col++) grid[row][col] = at(row, col);
+        }
+    }
+};
+
+using Board4 = Board<2, 2>;
+using Board6 = Board<2, 3>;
+using Board9 = Board<3, 3>;
+using Board12 = Board<3, 4>;
+using Board16 = Board<4, 4>;
+using Board25 = Board<5, 5>;
+
+// the board behind the SIZE-based std::vector APIs used by the GUI
+using ClassicBoard = Board<BOX_SIZE, BOX_SIZE>;
+
+// Sizes the templated engines are compiled for, used for explicit instantiation in the .cpp files
+#define SUDOKUX_FOR_EACH_BOARD(X) X(Board4) X(Board6) X(Board9) X(Board12) X(Board16) X(Board25)
+
+// ------------------------
+// Runtime size selection: calls f with a Board of the requested size, so everything past the
+// switch runs the size-specialized engine. Sizes outside BOARD_SIZES throw
+// std::invalid_argument rather than running a board of the wrong shape over the caller's grid.
+// ------------------------
+
+constexpr int BOARD_SIZES[] = {Board4::size, Board6::size, Board9::size, Board12::size, Board16::size, Board25::size};
+
+template <class F>
+decltype(auto) withBoard(int size, F&& f) {
+    switch (size) {
+        case Board4::size:
+            return f(Board4{});
+        case Board6::size:
+            return f(Board6{});
+        case Board9::size:
+            return f(Board9{});
+        case Board12::size:
+            return f(Board12{});
+        case Board16::size:
+            return f(Board16{});
+        case Board25::size:
+            return f(Board25{});
+        default:
+            throw std::invalid_argument("unsupported board size " + std::to_string(size));
+    }
+}
+
+struct BoxShape {
+    int rows;
+    int cols;
+};
+
+inline BoxShape boxShapeOf(int size) {
+    return withBoard(size, [](auto board) { return BoxShape{board.boxRows, board.boxCols}; });
+}
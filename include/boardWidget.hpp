@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "imgui.h"
+
+// ------------------------
+// Board widget drawn straight into the window's ImDrawList: one invisible item covers the
+// whole board and clicks are mapped back to cells arithmetically, so there are no per-cell
+// buttons, labels or ID strings and nothing is allocated per frame.
+// ------------------------
+
+constexpr int MAX_BOARD_SIDE = 25;
+constexpr int MAX_BOARD_CELLS = MAX_BOARD_SIDE * MAX_BOARD_SIDE;
+
+enum CellStyle : uint8_t {
+    CELL_NORMAL,
+    CELL_GIVEN,     // light blue
+    CELL_SELECTED,  // dark blue
+    CELL_INVALID,   // red
+};
+
+// Static "1".."25" glyphs, "" for EMPTY
+const char* digitGlyph(int digit);
+
+// Cell side and total width of a size x size board in the current window
+struct BoardLayout {
+    float cellSize;
+    float cellGap;  // between cells of one box
+    float boxGap;   // between boxes
+    float width;
+};
+
+BoardLayout boardLayout(int size, float windowWidth);
+
+// Draws the board centred in the current window. styles holds size * size entries, row-major.
+// Returns true with clickedRow / clickedCol set when a cell was clicked this frame.
+bool drawBoard(const char* id, const std::vector<std::vector<int>>& grid, const uint8_t* styles, int& clickedRow, int& clickedCol);
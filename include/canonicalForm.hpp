@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "flatGrid.hpp"
+#include "symmetry.hpp"
+
+namespace canonical {
+
+// ------------------------
+// Canonical form = lexicographically minimal grid (row-major, EMPTY sorts first) over the
+// whole symmetry group. Two puzzles are equivalent iff their canonical grids are equal.
+// Very sparse puzzles tie on millions of partial transforms; the search keeps at most
+// MAX_TIE_STATES of them and marks the result inexact when it had to drop some.
+// ------------------------
+
+// every real puzzle seen stays under 2600, ~12 givens reach ~5000, an empty grid 3.4 million
+constexpr size_t MAX_TIE_STATES = 8192;
+
+struct CanonicalForm {
+    FlatGrid grid;
+    symmetry::Transform transform;  // maps the input onto grid
+    // False if tie states were dropped: grid is still the image of the input under transform,
+    // but an equivalent puzzle may canonicalize to a different grid
+    bool exact = true;
+};
+
+struct Hash128 {
+    uint64_t high;
+    uint64_t low;
+
+    bool operator==(const Hash128& other) const { return high == other.high && low == other.low; }
+    bool operator!=(const Hash128& other) const { return !(*this == other); }
+};
+
+// for std::unordered_map / unordered_set keys
+struct Hash128Hasher {
+    size_t operator()(const Hash128& hash) const { return static_cast<size_t>(hash.low); }
+};
+
+CanonicalForm canonicalize(const FlatGrid& puzzle);
+
+uint64_t hash64(const FlatGrid& grid);
+
+Hash128 hash128(const FlatGrid& grid);
+
+// hash128(canonicalize(puzzle).grid)
+Hash128 canonicalHash(const FlatGrid& puzzle);
+
+// Cheap symmetry invariant (givens per line/band/box, digit frequencies): equivalent puzzles
+// always agree, so differing values rule out equivalence without running canonicalize().
+uint64_t invariantHash(const FlatGrid& puzzle);
+
+// ------------------------
+// Corpus deduplication. Puzzles are bucketed by invariantHash and only canonicalized when
+// a bucket already holds a candidate, which keeps mostly-distinct corpora off the slow path.
+// Inexact forms can only miss a duplicate, never merge puzzles that are not equivalent.
+// ------------------------
+
+class Deduplicator {
+   private:
+    struct Entry {
+        FlatGrid puzzle;
+        bool hashed;
+        Hash128 canonical;
+    };
+
+    std::unordered_map<uint64_t, std::vector<Entry>> buckets;
+    size_t count = 0;
+
+   public:
+    // true if the puzzle is not equivalent to any puzzle inserted before
+    bool insert(const FlatGrid& puzzle);
+
+    size_t size() const { return count; }
+};
+
+}  // namespace canonical
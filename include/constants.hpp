@@ -1,4 +1,5 @@
 #pragma once
 
-constexpr int SIZE = 9;
+constexpr int BOX_SIZE = 3;
+constexpr int SIZE = BOX_SIZE * BOX_SIZE;
 constexpr int EMPTY = 0;
\ No newline at end of file
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <memory>
+
+#include "solveTask.hpp"
+#include "solverTrace.hpp"
+
 namespace DLX {
 
 
@@ -53,5 +58,9 @@ void PrintGrid(std::vector<std::vector<int>>& grid);
 
 bool solver(std::vector<std::vector<int>>& grid);
 
-void solve(std::vector<std::vector<int>>& grid);
+// trace, if given, receives every placement and removal; traced solves always use the compact solver
+void solve(std::vector<std::vector<int>>& grid, trace::Recorder* trace = nullptr);
+
+// the compact solver's search, one step per row chosen or backed out of
+std::unique_ptr<SolveTask> makeSolveTask(const std::vector<std::vector<int>>& grid);
 }  // namespace DLX
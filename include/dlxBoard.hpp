@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "board.hpp"
+#include "constants.hpp"
+#include "solverStats.hpp"
+#include "solverTrace.hpp"
+
+namespace DLX {
+
+// ------------------------
+// Compact exact-cover solver for the larger boards. Only the candidates left open by the
+// givens become matrix rows and satisfied constraints get no column, so no dense
+// 15625 x 2500 matrix is ever built for 25x25. Nodes live in one
+// arena addressed by int indices; every instance owns its state, so separate instances
+// can run on separate threads. Instantiated for every board in SUDOKUX_FOR_EACH_BOARD.
+// ------------------------
+
+template <class B>
+class ExactCover {
+   private:
+    // node 0 is the root, nodes 1..columnCount the column headers
+    std::vector<int> left, right, up, down, column;
+    std::vector<int> rowOfNode;
+    std::vector<int> columnSize;
+
+    // matrix row -> (cell, digit)
+    std::vector<int> rowCell;
+    std::vector<uint8_t> rowDigit;
+
+    std::vector<int> chosen;  // node picked at each search depth
+
+    // cell * N + digit - 1 -> first node of its matrix row, -1 unless it is an open candidate
+    std::vector<int> candidateNode;
+    std::vector<int> assumed;   // rows placed by assume(), outside any search
+    std::vector<int> excluded;  // rows unlinked by exclude()
+
+    // resume() keeps its place between calls
+    std::vector<int> chosenColumn;  // column covered at each search depth
+    int resumeDepth = -1;           // -1 until the first call
+    bool descending = true;         // false while backing up
+    B puzzle;
+    bool contradiction = false;  // the givens already break a constraint
+    trace::Recorder* recorder = nullptr;
+
+    int newNode(int col);
+    void cover(int col);
+    void uncover(int col);
+    int chooseColumn() const;
+    bool isLinked(int node) const;
+    void writeSolution(int depth, B& solution) const;
+    template <bool TRACED>
+    void search(int depth, int limit, int& found, B& solution);
+    int count(int limit, B& solution);  // solution receives the first one found
+
+   public:
+    explicit ExactCover(const B& puzzle);
+
+    // fills solution with the first solution found, false if there is none
+    bool solve(B& solution);
+
+    // The search of solve() in slices of at most steps row choices, for callers that cannot
+    // block. True once finished; solved then tells whether solution was filled.
+    bool resume(long steps, B& solution, bool& solved);
+
+    // number of solutions, stopping once limit is reached
+    int count(int limit);
+
+    // Edits between searches, so one matrix serves a series of related puzzles. assume() places
+    // digit at cell as if it were a given, exclude() rules the candidate out; each is undone by
+    // release() / restore(), and all of them unwind in the reverse order they were made. Both
+    // return false and change nothing unless (cell, digit) is still an open candidate.
+    bool assume(int cell, int digit);
+    void release();
+    bool exclude(int cell, int digit);
+    void restore();
+
+    // Records the rows the search tries until its first solution, nullptr stops recording
+    void record(trace::Recorder* trace) { recorder = trace; }
+};
+
+template <class B>
+bool solve(B& board);
+
+template <class B>
+int countSolutions(const B& board, int limit);
+
+// A solution with digit ruled out at the empty cell, false if there is none. With digit taken
+// from a known solution this asks "is that solution unique at this cell" and, if not, returns
+// the counterexample.
+template <class B>
+bool solveExcluding(const B& board, int cell, int digit, B& solution);
+
+}  // namespace DLX
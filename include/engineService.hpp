@@ -0,0 +1,54 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "flatGrid.hpp"
+#include "puzzlePool.hpp"
+#include "solutionCache.hpp"
+#include "solverStats.hpp"
+
+// ------------------------
+// Thread-safe facade over the engines for the headless front ends (HTTP server, line daemon).
+// Solving goes through the solution cache and a per-call DLX instance, generation through the
+// pre-generated pool, so any number of worker threads can call in concurrently.
+// ------------------------
+
+constexpr int SERVICE_DIFFICULTIES = POOL_DIFFICULTIES;  // Easy..Evil by rater tier, 4 = minimal Impossible
+
+struct Rating {
+    int givens;
+    int solutions;        // counted up to 2, 2 means "more than one"
+    int difficulty;       // technique tier 0..4, -1 when the puzzle is not uniquely solvable
+    int score;            // rater::Rating::score, 0 when invalid
+    const char* label;    // "Easy".."Impossible", "Invalid"
+    const char* hardest;  // hardest technique needed, "" when invalid or beyond the ladder
+};
+
+class EngineService {
+   private:
+    std::unique_ptr<PuzzlePool> pool;
+    SolutionCache cache;
+
+   public:
+    explicit EngineService(size_t cacheCapacity);
+
+    // false if the puzzle has no solution
+    bool solve(const FlatGrid& puzzle, FlatGrid& solution);
+
+    int countSolutions(const FlatGrid& puzzle, int limit);
+
+    // Solves past the cache and returns the engine's counters, all zero unless built with
+    // SUDOKUX_ENABLE_STATS. False if the puzzle has no solution.
+    bool profile(const FlatGrid& puzzle, stats::SolverStats& counters);
+
+    // difficulty 0..SERVICE_DIFFICULTIES - 1
+    FlatGrid generate(int difficulty);
+
+    Rating rate(const FlatGrid& puzzle);
+
+    // same order as PuzzlePool: load, then start the background generators
+    bool loadPool(const std::string& path) { return pool->load(path); }
+    void startPool(int workers) { pool->start(workers); }
+    bool savePool(const std::string& path) { return pool->save(path); }
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+#include "constants.hpp"
+
+// ------------------------
+// Compact row-major grid: one byte per cell, EMPTY for holes.
+// Used by the batch paths (symmetry, canonical form, I/O) where vector<vector<int>> is too heavy.
+// ------------------------
+
+constexpr int CELLS = SIZE * SIZE;
+
+using FlatGrid = std::array<uint8_t, CELLS>;
+using FlatGivens = std::bitset<CELLS>;
+
+FlatGrid flatten(const std::vector<std::vector<int>>& grid);
+
+FlatGivens flattenGivens(const std::vector<std::vector<bool>>& givens);
+
+void unflatten(const FlatGrid& flat, std::vector<std::vector<int>>& grid);
+
+void unflattenGivens(const FlatGivens& flat, std::vector<std::vector<bool>>& givens);
@@ -2,15 +2,33 @@
 
 #include <atomic>
 #include <chrono>
+#include <functional>
 #include <memory>
-#include <thread>
+#include <mutex>
+#include <string>
 #include <vector>
 
 #include "backtracking.hpp"
 #include "dlx.hpp"
 #include "imgui.h"
 #include "imgui_internal.h"
+#include "playerBoard.hpp"
+#include "puzzlePool.hpp"
 #include "simulatedAnnealing.hpp"
+#include "solutionCache.hpp"
+#include "solveTask.hpp"
+#include "solverStats.hpp"
+#include "traceReplay.hpp"
+#include "workerPool.hpp"
+
+// UI fonts, under FONT_DIR
+#ifdef __EMSCRIPTEN__
+constexpr const char* FONT_DIR = "assets/font/";
+#else
+constexpr const char* FONT_DIR = "../assets/font/";  // Native builds use the relative path
+#endif
+constexpr const char* MAIN_FONT_FILE = "BebasNeue-Regular.ttf";
+constexpr const char* HEADING_FONT_FILE = "Boldonse-Regular.ttf";
 
 constexpr ImVec4 RGBA(int R, int G, int B, float A = 1.0f) { return ImVec4(R / 255.0f, G / 255.0f, B / 255.0f, A); }
 
@@ -19,8 +37,17 @@ constexpr int ALGO_BACKTRACKING = 1;
 constexpr int ALGO_SIMULATED_ANNEALING = 2;
 constexpr int ALGO_DLX = 3;
 
+// plain backtracking and annealing do not finish in interactive time past 9x9
+constexpr bool algoSupportsSize(int algo, int size) { return algo == ALGO_DLX || algo == ALGO_ALL || size <= SIZE; }
+
+struct AlgoResult {
+    std::string name;
+    double milliseconds;
+    stats::SolverStats stats;  // all zero unless built with SUDOKUX_ENABLE_STATS
+};
+
 enum class GameState {
-    // SizeSelection,  // main menu
+    SizeSelection,  // main menu
     DifficultySelection,
     WhoPlaysSelection,
     AlgoSelection,
@@ -42,15 +69,18 @@ class GUI {
 
     std::vector<std::vector<int>> grid;
     std::vector<std::vector<bool>> givens;
+    PlayerBoard player;  // conflict counters for grid in UserPlayingMode
     GameState gameState;
     double timeTaken;
-    std::vector<std::pair<std::string, double>> timeResults;
+    stats::SolverStats solveStats;
+    std::vector<AlgoResult> timeResults;  // fastest first
 
     bool game_started;
     bool game_solving;
     bool game_solved;
 
     int selected_mode;
+    int selected_size = SIZE;
     int selected_difficulty;
     int selected_algo;
 
@@ -58,8 +88,41 @@ class GUI {
     double runningTime = 0;
     bool timerRunning = false;
 
-    std::unique_ptr<std::thread> solverThread;
+    std::unique_ptr<WorkerPool> solverPool;  // one dedicated solver thread, null without threads
     std::atomic<bool> solverRunning;
+    std::atomic<bool> frameRequested{false};  // a solve or generation finished off the main thread
+    std::function<void()> wakeHandler;
+
+    // An on-demand puzzle is generated on the solver worker while the screen shows a spinner;
+    // puzzleReady() moves it into grid on a later frame. Results of abandoned requests carry
+    // an older ticket and are dropped.
+    bool generatePending = false;
+    int generateTicket = 0;
+    std::mutex generatedMutex;
+    Puzzle generated;
+    int generatedTicket = -1;
+    std::unique_ptr<GenerateTask> steppedGenerate;  // without threads, stepped on the main loop
+
+    // Builds without threads step the solve on the main loop instead, a few slices per frame
+    struct SteppedSolve {
+        const char* name;
+        std::unique_ptr<SolveTask> task;
+        double milliseconds = 0;  // time spent inside run()
+        stats::SolverStats stats;
+    };
+    std::vector<SteppedSolve> steppedSolves;  // in run order, the last one's board is shown
+    size_t steppedIndex = 0;
+
+    std::unique_ptr<PuzzlePool> puzzlePool;
+
+    SolutionCache solutionCache;
+    bool use_solution_cache = true;
+    std::atomic<bool> solvedFromCache{false};
+
+    bool record_trace = false;
+    std::unique_ptr<trace::Recorder> traceRecorder;  // allocated on the first traced solve
+    bool replay_pending = false;                     // start the replay once the traced solve is done
+    TraceReplay traceReplay;
 
     bool hasPrinted;  // for debbuging
 
@@ -68,19 +131,42 @@ class GUI {
 
     ~GUI();
 
+    // Adds the UI fonts to the atlas, false if a file is missing (ImGui's default font is used
+    // in its place). Lazy-font builds call it once the files are fetched, then rebuild the
+    // font texture.
+    bool loadFonts();
+
     // UI functions
 
     bool Spinner(const char* label, float radius, int thickness, const ImU32& color);
     void renderTime();
+    void renderGenerating();
     void renderUI();
 
+    // Seconds until the UI changes without input: 0 while a solver or generation spinner
+    // animates or a stepped solve is pending, the time to the next clock tick while the player's timer runs,
+    // infinity on static screens
+    double idleTimeout() const;
+
+    // A threaded solve can finish after the loop drew its last spinner frame and went idle on
+    // infinity. The solver thread then raises a frame request, which the loop takes each
+    // iteration, and calls handler to end a blocking wait; handler must be thread-safe.
+    void setWakeHandler(std::function<void()> handler) { wakeHandler = std::move(handler); }
+    bool takeFrameRequest() { return frameRequested.exchange(false); }
+
     // puzzle functions
 
+    // Fills grid / givens from the pool if it can, otherwise starts an on-demand generation
     void generatePuzzle();
+    bool puzzleReady();  // false while an on-demand generation is still running
+    void requestFrame();  // from worker threads: the main loop should draw again
     void solvePuzzleByAlgo();
+    void stepSolve();  // advances a stepped solve within the frame budget
+    void stepGenerate();  // advances a stepped generation within the frame budget
 
     // state functions
 
+    void stateSizeSelection();
     void stateDifficultySelection();
     void stateWhoPlaysSelection();
     void stateAlgoSelection();
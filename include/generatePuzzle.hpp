@@ -1,15 +1,21 @@
 #pragma once
 
 #include <algorithm>
+#include <bitset>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <functional>
 #include <iostream>
+#include <memory>
 #include <random>
 #include <vector>
 
+#include "board.hpp"
 #include "constants.hpp"
 
+class WorkerPool;
+
 // ------------------------
 // Backtracker to generate complete grid
 // ------------------------
@@ -18,16 +24,18 @@ bool isValid(std::vector<std::vector<int>>& grid, int row, int col, int num);
 
 bool fillGrid(std::vector<std::vector<int>>& grid);
 
+// Randomized variant (fillBoard on the classic board): every call (or every seed) yields a
+// different complete grid.
+bool fillGridRandom(std::vector<std::vector<int>>& grid, std::mt19937& rng);
+
+bool fillGridRandom(std::vector<std::vector<int>>& grid, uint32_t seed);
+
 // ------------------------
 // Uniqueness checking
 // ------------------------
 
-bool solveUnique(std::vector<std::vector<int>>& grid, int& count);
-
 bool hasUniqueSolution(std::vector<std::vector<int>> grid);
 
-std::vector<std::pair<int, int>> generateSequence();
-
 // ------------------------
 // puzzle generator using Digging Holes to make holes in the complete grid
 // ------------------------
@@ -39,12 +47,115 @@ struct DifficultyMetrics {
 
 DifficultyMetrics getDifficultyMetrics(int difficulty);
 
+// metrics scaled to a size x size board
+DifficultyMetrics getDifficultyMetrics(int difficulty, int size);
+
 int countGivens(const std::vector<std::vector<int>>& grid);
 
-int countRowGivens(const std::vector<std::vector<int>>& grid, int row);
+void getImpossibleGrid(std::vector<std::vector<int>>& grid, std::vector<std::vector<bool>>& givens);
 
-int countColGivens(const std::vector<std::vector<int>>& grid, int col);
+void digHoles(std::vector<std::vector<int>>& grid, std::vector<std::vector<bool>>& givens, int difficulty);
 
-void getImpossibleGrid(std::vector<std::vector<int>>& grid, std::vector<std::vector<bool>>& givens);
+// ------------------------
+// complete puzzle = filled grid + dug holes
+// ------------------------
+
+struct Puzzle {
+    std::vector<std::vector<int>> grid;
+    std::vector<std::vector<bool>> givens;
+    int tier = -1;  // rater tier, set by makeRatedPuzzle
+};
+
+// "Impossible": a minimal puzzle of at most IMPOSSIBLE_MAX_GIVENS givens that needs Evil
+// techniques or more
+constexpr int IMPOSSIBLE_DIFFICULTY = 4;
+constexpr int IMPOSSIBLE_MAX_GIVENS = 22;
+
+Puzzle makePuzzle(int difficulty);
+
+// any size in BOARD_SIZES, dispatched to the size-specialized generator
+Puzzle makePuzzle(int size, int difficulty);
+
+// Classic puzzle that needs exactly the given rater tier (0 Easy .. 4 beyond the technique
+// ladder): digs while re-rating and undoes removals that overshoot. With helpers, one candidate
+// dig per worker runs next to the caller's and the first to land in the tier wins. After
+// MAX_RATED_ATTEMPTS digs without a hit, the closest (highest) tier reached is returned;
+// puzzle.tier says which. Tiers 2-3 take 6 digs at the median and ~50 at worst, ~2.5 ms each.
+constexpr int MAX_RATED_ATTEMPTS = 256;
+
+Puzzle makeRatedPuzzle(int tier, WorkerPool* helpers = nullptr);
+
+// Classic minimal puzzle (no given can go) with at most maxGivens givens and a rater tier of at
+// least minTier. Random minimal puzzles have 21-27 givens, ~4% have 22 or fewer. After
+// MAX_MINIMAL_ATTEMPTS reductions without one, the closest candidate is returned (the higher
+// tier, then the fewer givens). Impossible takes 78 reductions at the median and ~570 at worst
+// (~1% miss the cap), ~0.9 ms each.
+constexpr int MAX_MINIMAL_ATTEMPTS = 512;
+
+Puzzle makeMinimalPuzzle(int maxGivens, int minTier);
+
+// ------------------------
+// A generation that can be paused, the counterpart of SolveTask for builds without threads.
+// run() makes one attempt and returns: a rated dig (~2.5 ms native), a minimal reduction
+// (~1 ms), or the fill / one checked removal on the other sizes. A removal is one uniqueness
+// check, so a single run() on 16x16 / 25x25 Impossible can still take ~250 ms.
+// ------------------------
+
+class GenerateTask {
+   public:
+    virtual ~GenerateTask() = default;
+
+    // one attempt, true once finished
+    virtual bool run() = 0;
+
+    // the generated puzzle, once run() returned true
+    virtual Puzzle result() const = 0;
+};
+
+// What generating a size x size puzzle of the difficulty takes without the pool: a rated dig
+// for the classic tiers, a minimal puzzle for classic Impossible, makePuzzle(size, difficulty)
+// for the other sizes
+std::unique_ptr<GenerateTask> makeGenerateTask(int size, int difficulty);
+
+// ------------------------
+// Size-specialized generator, instantiated for every board in SUDOKUX_FOR_EACH_BOARD
+// ------------------------
+
+// Complete random board: row/col/box bitmasks, fewest-candidates cell first, candidates tried
+// in shuffled order, restarting if a fill stalls (only happens on the larger boards)
+template <class B>
+bool fillBoard(B& board, std::mt19937& rng);
+
+// Number of solutions, the search stops as soon as limit is reached
+template <class B>
+int countSolutions(const B& board, int limit);
+
+template <class B>
+bool hasUniqueSolution(const B& board);
+
+// Digs holes in a complete board in random order while the solution stays unique,
+// until metrics.targetGivens is reached
+template <class B>
+void digHoles(B& board, const DifficultyMetrics& metrics, std::mt19937& rng);
+
+// ------------------------
+// Minimal puzzles: every given is necessary for a unique solution
+// ------------------------
+
+template <class B>
+using CellSet = std::bitset<B::cellCount>;
+
+// Unavoidable sets of a complete grid are cells whose digits can be rearranged into another
+// valid grid, so every puzzle of that grid keeps a given in each of them. These are the 4-cell
+// ones: two rows, two columns, two boxes, digits ab/ba.
+template <class B>
+std::vector<CellSet<B>> findUnavoidableRectangles(const B& solution);
+
+// Removes givens in random order until the puzzle is minimal; board must have a unique
+// solution. unavoidable holds sets known for its solution grid and collects the new ones
+// found on the way, so reducing the same grid again in another order gets cheaper.
+template <class B>
+void reduceToMinimal(B& board, std::vector<CellSet<B>>& unavoidable, std::mt19937& rng);
 
-void digHoles(std::vector<std::vector<int>>& grid, std::vector<std::vector<bool>>& givens, int difficulty);
\ No newline at end of file
+template <class B>
+void reduceToMinimal(B& board, std::mt19937& rng);
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "workerPool.hpp"
+
+// ------------------------
+// Minimal HTTP/1.1 server on POSIX sockets, loopback only. One thread multiplexes every
+// connection with poll(); parsed requests are handed to the worker pool in batches (all the
+// pipelined requests read from a connection in one go travel as one job) and responses are
+// written back in request order, connections stay open (keep-alive) unless the client asks.
+// ------------------------
+
+struct HttpRequest {
+    std::string method;
+    std::string path;   // without the query string
+    std::string query;  // after '?', undecoded
+    std::string body;
+};
+
+struct HttpResponse {
+    int status = 200;
+    std::string contentType = "application/json";
+    std::string body;
+};
+
+// Called on worker threads, concurrently
+using HttpHandler = std::function<HttpResponse(const HttpRequest&)>;
+
+// value of key in a "a=1&b=2" query string, empty if absent
+std::string queryParameter(const std::string& query, const std::string& key);
+
+// Appends text as a quoted JSON string: quotes, backslashes and control characters escaped
+void appendJsonString(std::string& out, const std::string& text);
+
+class HttpServer {
+   private:
+    struct Slot {
+        bool ready = false;  // guarded by HttpServer::completionMutex
+        std::string bytes;   // serialized response
+    };
+
+    struct Connection {
+        int fd;
+        std::string input;
+        std::string output;
+        size_t outputSent = 0;
+        std::deque<std::shared_ptr<Slot>> pending;  // responses in request order
+        bool closeAfterPending = false;
+        bool peerClosed = false;  // read side hit EOF
+        std::chrono::steady_clock::time_point lastActivity;
+    };
+
+    WorkerPool& workers;
+    HttpHandler handler;
+    int listenFd = -1;
+    int wakePipe[2] = {-1, -1};
+    std::atomic<bool> stopping{false};
+    std::mutex completionMutex;
+    std::atomic<int> jobsInFlight{0};  // run() waits for these so jobs never outlive the server
+    std::vector<std::unique_ptr<Connection>> connections;
+
+    void acceptConnections();
+    bool readInput(Connection& connection);  // false on a read error
+    void parseRequests(Connection& connection);
+    void collectResponses(Connection& connection);
+    bool writeOutput(Connection& connection);  // false on a write error
+    void wake();
+
+   public:
+    HttpServer(WorkerPool& workers, HttpHandler handler);
+    ~HttpServer();
+
+    HttpServer(const HttpServer&) = delete;
+    HttpServer& operator=(const HttpServer&) = delete;
+
+    // binds 127.0.0.1:port, false (with a message on stderr) on failure
+    bool listen(uint16_t port);
+
+    // serves until stop() is called
+    void run();
+
+    // safe to call from a signal handler
+    void stop();
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace perf {
+
+// ------------------------
+// Hardware counters for the benchmark through perf_event_open (Linux), one event per counter,
+// user space only, counting the calling thread. An event the kernel or CPU refuses (no PMU
+// in a VM, perf_event_paranoid) reads as unavailable while the others still count. When
+// there are more events than PMU slots the kernel multiplexes them, and readings are scaled
+// by enabled / running time. Other platforms get a stub where nothing is available.
+// ------------------------
+
+enum Counter {
+    CYCLES,
+    INSTRUCTIONS,
+    BRANCH_MISSES,
+    L1D_MISSES,  // L1 data cache read misses
+    LLC_MISSES,  // the kernel's generic cache-misses event, last level on most CPUs
+    COUNTER_COUNT
+};
+
+const char* counterName(int counter);
+
+struct Reading {
+    std::array<double, COUNTER_COUNT> values{};
+    std::array<bool, COUNTER_COUNT> valid{};
+};
+
+class Counters {
+   private:
+    std::array<int, COUNTER_COUNT> fds;
+
+   public:
+    // opens every event, disabled
+    Counters();
+    ~Counters();
+
+    Counters(const Counters&) = delete;
+    Counters& operator=(const Counters&) = delete;
+
+    // at least one event opened
+    bool available() const;
+
+    // zeroes and enables every event
+    void start();
+    void stop();
+
+    Reading read() const;
+};
+
+}  // namespace perf
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "board.hpp"
+
+// ------------------------
+// Conflict bookkeeping for the interactive player: per-row, per-column and per-box digit
+// counters, updated only when a cell changes. Conflict and solved queries are O(1), so an
+// idle frame never rescans the grid.
+// ------------------------
+
+class PlayerBoard {
+   private:
+    int size = 0;
+    BoxShape box{};
+    std::vector<uint8_t> rowCounts;  // [unit * (size + 1) + digit], same layout for all three
+    std::vector<uint8_t> colCounts;
+    std::vector<uint8_t> boxCounts;
+    int filled = 0;
+    int duplicates = 0;    // over all units and digits, copies beyond the first
+    uint32_t version = 0;  // bumped on every change
+
+    int boxOf(int row, int col) const { return (row / box.rows) * box.rows + col / box.cols; }
+    void count(std::vector<uint8_t>& counts, int unit, int digit, int delta);
+    void add(int row, int col, int digit, int delta);
+
+   public:
+    // Recounts from scratch, call whenever grid is replaced or edited outside place()
+    void reset(const std::vector<std::vector<int>>& grid);
+
+    // Writes digit (EMPTY clears) to grid[row][col] and updates the counters
+    void place(std::vector<std::vector<int>>& grid, int row, int col, int digit);
+
+    // true if digit at (row, col) clashes with another cell of its row, column or box
+    bool conflicts(int row, int col, int digit) const;
+
+    // every cell filled and no unit repeats a digit
+    bool solved() const { return size > 0 && filled == size * size && duplicates == 0; }
+
+    // changes whenever the counters do, lets renderers cache per-cell state
+    uint32_t revision() const { return version; }
+};
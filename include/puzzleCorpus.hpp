@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "flatGrid.hpp"
+#include "puzzleIO.hpp"
+
+namespace corpus {
+
+// ------------------------
+// Binary puzzle bank. Fixed-width records after a 32-byte header, so record i sits at
+// HEADER_BYTES + i * recordBytes and a whole bank loads with one mmap.
+//
+//   header:  "SDXB" | version u16 | flags u16 | cells u16 | recordBytes u16 | count u64 | reserved
+//   record:  tag u8 | puzzle, 4 bits per cell | solution, 4 bits per cell (if FLAG_SOLUTIONS)
+//
+// Holes are 0, so the givens mask is implied by the puzzle nibbles. The tag is free for the
+// caller (difficulty, rating). All integers are little-endian.
+// ------------------------
+
+static_assert(SIZE <= 15, "cells are stored as nibbles");
+
+constexpr uint16_t FORMAT_VERSION = 1;
+constexpr uint16_t FLAG_SOLUTIONS = 1;
+constexpr size_t HEADER_BYTES = 32;
+constexpr size_t PACKED_BYTES = (CELLS + 1) / 2;
+
+using PackedGrid = std::array<uint8_t, PACKED_BYTES>;
+
+void pack(const FlatGrid& grid, uint8_t* out);
+
+void unpack(const uint8_t* packed, FlatGrid& grid);
+
+inline PackedGrid pack(const FlatGrid& grid) {
+    PackedGrid packed;
+    pack(grid, packed.data());
+    return packed;
+}
+
+class CorpusWriter {
+   private:
+    std::ofstream file;
+    bool withSolutions = false;
+    uint64_t count = 0;
+
+    void writeHeader();
+
+   public:
+    CorpusWriter() = default;
+    ~CorpusWriter();
+
+    bool open(const std::string& path, bool solutions);
+
+    void append(const FlatGrid& puzzle, uint8_t tag = 0);
+
+    // banks opened with solutions = true only
+    void append(const FlatGrid& puzzle, const FlatGrid& solution, uint8_t tag = 0);
+
+    // patches the record count into the header, false if any write failed
+    bool close();
+};
+
+class CorpusReader {
+   private:
+    puzzleIO::MappedFile file;
+    const uint8_t* records = nullptr;
+    size_t recordBytes = 0;
+    uint64_t count = 0;
+    bool solutions = false;
+
+    const uint8_t* record(size_t index) const { return records + index * recordBytes; }
+
+   public:
+    // false if the file is missing, truncated or not a bank for this SIZE
+    bool open(const std::string& path);
+
+    size_t size() const { return static_cast<size_t>(count); }
+    bool hasSolutions() const { return solutions; }
+
+    uint8_t tag(size_t index) const { return record(index)[0]; }
+    void puzzle(size_t index, FlatGrid& grid) const { unpack(record(index) + 1, grid); }
+    void solution(size_t index, FlatGrid& grid) const { unpack(record(index) + 1 + PACKED_BYTES, grid); }
+};
+
+}  // namespace corpus
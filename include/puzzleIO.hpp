@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "flatGrid.hpp"
+
+namespace puzzleIO {
+
+// ------------------------
+// Bulk text I/O: one puzzle per line, CELLS characters, '0' or '.' for holes, anything after
+// the cells (solution, rating, '\r') is ignored. Input is memory-mapped and parsed straight
+// into FlatGrid, output goes through one large buffer.
+// ------------------------
+
+static_assert(SIZE <= 9, "the text format stores one character per cell");
+
+// Read-only view of a whole file: mmap on POSIX, a plain read into memory elsewhere
+class MappedFile {
+   private:
+    const char* bytes = nullptr;
+    size_t length = 0;
+    bool opened = false;
+    bool mapped = false;  // bytes is an mmap region rather than fallback's storage
+    std::vector<char> fallback;
+
+   public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return opened; }
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+};
+
+// Checks and converts CELLS characters ('1'-'9', '0' or '.') into out; false on any other byte.
+// SSE2 converts 16 cells per step, other targets use the scalar loop.
+bool parseCells(const char* text, FlatGrid& out);
+
+// Writes CELLS digit characters, EMPTY as '0'
+void formatCells(const FlatGrid& grid, char* text);
+
+class PuzzleReader {
+   private:
+    const char* cursor;
+    const char* end;
+    size_t skippedLines = 0;
+
+   public:
+    PuzzleReader(const char* data, size_t size) : cursor(data), end(data + size) {}
+    explicit PuzzleReader(const MappedFile& file) : PuzzleReader(file.data(), file.size()) {}
+
+    // next well-formed puzzle, false at end of input; malformed lines are skipped and counted
+    bool next(FlatGrid& grid);
+
+    size_t skipped() const { return skippedLines; }
+};
+
+class PuzzleWriter {
+   private:
+    static constexpr size_t BUFFER_SIZE = 1 << 20;
+
+    std::FILE* file = nullptr;
+    bool ownsFile = false;
+    std::vector<char> buffer;
+    size_t used = 0;
+    bool failed = false;
+
+    char* reserve(size_t bytes);
+
+   public:
+    PuzzleWriter();
+    explicit PuzzleWriter(std::FILE* file);  // not closed by the writer, e.g. stdout
+    ~PuzzleWriter();
+
+    PuzzleWriter(const PuzzleWriter&) = delete;
+    PuzzleWriter& operator=(const PuzzleWriter&) = delete;
+
+    bool open(const std::string& path);
+
+    // "<cells>\n"
+    void write(const FlatGrid& grid);
+
+    // "<puzzle cells>,<solution cells>\n"
+    void write(const FlatGrid& puzzle, const FlatGrid& solution);
+
+    void write(const char* text, size_t length);
+
+    // false if any write so far failed
+    bool flush();
+};
+
+}  // namespace puzzleIO
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "canonicalForm.hpp"
+#include "generatePuzzle.hpp"
+
+// ------------------------
+// Pre-generated puzzles, one bounded ring buffer per difficulty.
+// Background workers keep the rings topped up so that handing a puzzle
+// to the user is an O(1) pop instead of a fillGrid + digHoles run.
+// Puzzles come from makeRatedPuzzle, so every ring up to Evil holds exactly its technique tier;
+// Impossible holds minimal puzzles from makePuzzle.
+// ------------------------
+
+constexpr int POOL_DIFFICULTIES = 5;  // Easy..Evil, Impossible
+constexpr int POOL_CAPACITY = 16;     // puzzles kept ready per difficulty
+
+class PuzzlePool {
+   private:
+    struct Ring {
+        std::array<Puzzle, POOL_CAPACITY> slots;
+        std::array<canonical::Hash128, POOL_CAPACITY> keys;  // canonical hashes, symmetric duplicates are rejected
+        int head = 0;
+        int count = 0;
+        int inFlight = 0;  // puzzles currently being generated for this ring
+    };
+
+    std::array<Ring, POOL_DIFFICULTIES> rings;
+    std::mutex mutex;
+    std::condition_variable refill;
+    std::vector<std::thread> workers;
+    bool stopping = false;
+
+    int neediestDifficulty() const;  // caller must hold the mutex
+    bool pushLocked(int difficulty, Puzzle&& puzzle, const canonical::Hash128& key);
+    void workerLoop();
+
+   public:
+    PuzzlePool() = default;
+
+    ~PuzzlePool();
+
+    PuzzlePool(const PuzzlePool&) = delete;
+    PuzzlePool& operator=(const PuzzlePool&) = delete;
+
+    // Spawns the background generators, call after load() so restored puzzles are not overproduced.
+    void start(int workerCount);
+
+    // Takes a ready puzzle, returns false if the ring for this difficulty is empty.
+    bool pop(int difficulty, Puzzle& out);
+
+    int size(int difficulty);
+
+    // Persist / restore ready puzzles so a restart does not begin with empty rings.
+    bool save(const std::string& path);
+    bool load(const std::string& path);
+};
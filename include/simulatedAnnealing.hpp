@@ -1,23 +1,51 @@
 #pragma once
 
 #include <algorithm>
+#include <bitset>
 #include <chrono>
 #include <cmath>
 #include <iostream>
+#include <memory>
 #include <random>
 #include <vector>
 
+#include "board.hpp"
+#include "solveTask.hpp"
+#include "solverStats.hpp"
+#include "solverTrace.hpp"
+
 namespace simulatedAnnealing {
 
 constexpr double INITIAL_TEMPERATURE = 1.0;
 constexpr double COOLING_RATE = 0.99999;
 constexpr int MAX_ITERATIONS = 1000000;
 
-int calculateScore(std::vector<std::vector<int>>& grid);
+// trace, if given, receives the initial fill and every accepted swap
+void solve(std::vector<std::vector<int>>& grid, std::vector<std::vector<bool>>& givens, trace::Recorder* trace = nullptr);
+
+// the same run as solve(), one step per iteration
+std::unique_ptr<SolveTask> makeSolveTask(const std::vector<std::vector<int>>& grid, const std::vector<std::vector<bool>>& givens);
+
+// ------------------------
+// Size-specialized engine, instantiated for every board in SUDOKUX_FOR_EACH_BOARD.
+// Boxes are always kept complete, the score counts digits missing from rows and cols.
+// ------------------------
+
+template <class B>
+using FixedCells = std::bitset<B::cellCount>;
+
+template <class B>
+int calculateScore(const B& board);
+
+template <class B>
+void randomizeGrid(B& board, std::mt19937& rng);
 
-void randomizeGrid(std::vector<std::vector<int>>& grid);
+// swaps two free cells of a random box into first / second, false if the box had none to swap
+template <class B>
+bool swapCells(B& board, const FixedCells<B>& fixed, std::mt19937& rng, int& first, int& second);
 
-void swapCells(std::vector<std::vector<int>>& grid, std::vector<std::vector<bool>>& givens);
+// cells holding a digit on entry are treated as givens
+template <class B>
+void solve(B& board, trace::Recorder* trace = nullptr);
 
-void solve(std::vector<std::vector<int>>& grid, std::vector<std::vector<bool>>& givens);
 }  // namespace simulatedAnnealing
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "canonicalForm.hpp"
+
+// ------------------------
+// LRU cache of solved puzzles keyed by canonical hash. Entries are stored in canonical
+// orientation, so a symmetric variant of a cached puzzle is also a hit: its solution is
+// mapped back through the inverse of the variant's canonicalizing transform.
+// Safe to share between threads.
+// ------------------------
+
+// No puzzle with fewer givens has a unique solution, and canonicalizing sparse grids is the
+// expensive case, so they bypass the cache entirely
+constexpr int MIN_CACHED_GIVENS = 17;
+
+class SolutionCache {
+   public:
+    // A puzzle's canonical form, computed once for a lookup() and the store() after it
+    struct Key {
+        bool cacheable = false;  // enough givens and an exact canonical form
+        canonical::CanonicalForm form;
+        canonical::Hash128 hash{};
+    };
+
+   private:
+    struct Entry {
+        canonical::Hash128 key;
+        FlatGrid puzzle;    // canonical puzzle, compared on hit to rule out hash collisions
+        FlatGrid solution;  // solution in the canonical orientation
+    };
+
+    size_t capacity;
+    std::list<Entry> entries;  // most recently used first
+    std::unordered_map<canonical::Hash128, std::list<Entry>::iterator, canonical::Hash128Hasher> index;
+    std::mutex mutex;
+    size_t hitCount = 0;
+    size_t missCount = 0;
+
+   public:
+    explicit SolutionCache(size_t capacity);
+
+    // skips canonicalization for puzzles under MIN_CACHED_GIVENS
+    static Key keyOf(const FlatGrid& puzzle);
+
+    // true on hit, solution is then in the orientation of the puzzle key was made from;
+    // always false for keys that are not cacheable
+    bool lookup(const Key& key, FlatGrid& solution);
+
+    // ignored unless key is cacheable and solution is a complete, valid solution of puzzle
+    void store(const Key& key, const FlatGrid& puzzle, const FlatGrid& solution);
+
+    // Solves grid in place through the cache, running solver only on a miss.
+    // Returns true on hit.
+    bool solve(std::vector<std::vector<int>>& grid, const std::function<void(std::vector<std::vector<int>>&)>& solver);
+
+    size_t hits();
+    size_t misses();
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <vector>
+
+// ------------------------
+// A solve that can be paused. run() advances the search by a bounded number of steps and
+// returns, so a build without threads can spread one solve over many frames of its main
+// loop. Each engine builds its own through makeSolveTask(); the search order matches the
+// engine's blocking solve.
+// ------------------------
+
+class SolveTask {
+   public:
+    virtual ~SolveTask() = default;
+
+    // advances by at most steps, true once the search has finished
+    virtual bool run(long steps) = 0;
+
+    // the board the search finished on, the puzzle itself if there is no solution
+    virtual void result(std::vector<std::vector<int>>& grid) const = 0;
+};
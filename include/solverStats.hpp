@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+namespace stats {
+
+// ------------------------
+// Search counters, compiled in with -DSUDOKUX_ENABLE_STATS. Engines report through the hooks
+// below into counters owned by the calling thread; in a default build the hooks are empty and
+// compile away. Callers reset() before a solve and take snapshot() after it, on the same thread.
+// ------------------------
+
+#ifdef SUDOKUX_ENABLE_STATS
+constexpr bool ENABLED = true;
+#else
+constexpr bool ENABLED = false;
+#endif
+
+struct SolverStats {
+    uint64_t nodes = 0;         // digits placed (backtracking) or rows chosen (DLX)
+    uint64_t backtracks = 0;    // of those, undone after a dead end
+    uint64_t maxDepth = 0;      // longest path of placements or rows
+    uint64_t covers = 0;        // DLX column operations
+    uint64_t uncovers = 0;
+    uint64_t accepted = 0;      // annealing moves kept
+    uint64_t rejected = 0;      // annealing moves discarded
+    uint64_t eliminations = 0;  // candidates removed by the technique rater's propagation
+};
+
+namespace detail {
+inline thread_local SolverStats counters;
+inline thread_local uint64_t depth = 0;
+}  // namespace detail
+
+// a placement or row choice one level deeper than the last
+inline void enter() {
+    if constexpr (ENABLED) {
+        detail::counters.nodes++;
+        detail::counters.maxDepth = std::max(detail::counters.maxDepth, ++detail::depth);
+    }
+}
+
+// undoes the matching enter(), deadEnd is false while unwinding from a solution
+inline void leave(bool deadEnd = true) {
+    if constexpr (ENABLED) {
+        detail::depth--;
+        detail::counters.backtracks += deadEnd;
+    }
+}
+
+inline void cover() {
+    if constexpr (ENABLED) detail::counters.covers++;
+}
+
+inline void uncover() {
+    if constexpr (ENABLED) detail::counters.uncovers++;
+}
+
+inline void move(bool accepted) {
+    if constexpr (ENABLED) (accepted ? detail::counters.accepted : detail::counters.rejected)++;
+}
+
+inline void eliminated(int candidates) {
+    if constexpr (ENABLED) detail::counters.eliminations += candidates;
+}
+
+// zeroes this thread's counters
+void reset();
+
+// this thread's counters so far
+SolverStats snapshot();
+
+// "nodes=N" followed by every other non-zero counter as key=value, space separated
+std::string format(const SolverStats& stats);
+
+}  // namespace stats
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace trace {
+
+// ------------------------
+// Search traces for the step-by-step replay. Engines given a Recorder append one 4-byte event
+// per placement or removal into a preallocated ring, so recording is a masked store and
+// never allocates; a search longer than the ring keeps its most recent events.
+// ------------------------
+
+enum class Action : uint8_t {
+    Place,   // EMPTY -> digit
+    Remove,  // digit -> EMPTY
+};
+
+struct Event {
+    uint16_t cell;  // row-major
+    uint8_t digit;
+    Action action;
+};
+
+constexpr size_t DEFAULT_CAPACITY = size_t{1} << 20;  // 4 MB of events
+
+class Recorder {
+   private:
+    std::vector<uint32_t> events;  // packed Events, one store per record
+    size_t mask;
+    uint64_t recorded = 0;
+
+    void push(int cell, int digit, Action action) { events[recorded++ & mask] = static_cast<uint32_t>(cell) | static_cast<uint32_t>(digit) << 16 | static_cast<uint32_t>(action) << 24; }
+
+   public:
+    // capacity is rounded up to a power of two
+    explicit Recorder(size_t capacity = DEFAULT_CAPACITY);
+
+    void clear() { recorded = 0; }
+
+    void place(int cell, int digit) { push(cell, digit, Action::Place); }
+    void remove(int cell, int digit) { push(cell, digit, Action::Remove); }
+
+    // events still held, oldest first through operator[]
+    size_t size() const { return static_cast<size_t>(std::min<uint64_t>(recorded, events.size())); }
+    uint64_t total() const { return recorded; }
+    uint64_t dropped() const { return recorded - size(); }
+
+    Event operator[](size_t i) const {
+        uint32_t packed = events[(dropped() + i) & mask];
+        return {static_cast<uint16_t>(packed & 0xFFFF), static_cast<uint8_t>(packed >> 16), static_cast<Action>(packed >> 24)};
+    }
+};
+
+// Applies event to row-major cells, backwards when undoing
+void apply(std::vector<uint8_t>& cells, const Event& event, bool undo = false);
+
+// The cells just before the oldest held event, rebuilt by undoing every held event from the
+// cells the search ended on. Equals the puzzle unless the ring wrapped.
+std::vector<uint8_t> windowStart(const Recorder& recorder, std::vector<uint8_t> endCells);
+
+}  // namespace trace
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "flatGrid.hpp"
+
+namespace symmetry {
+
+// ------------------------
+// One element of the Sudoku symmetry group (digit relabelling, band/stack permutation,
+// row/col permutation inside bands/stacks, transposition). Every operation maps a valid
+// puzzle to a valid puzzle with the same number of solutions and the same givens count.
+//
+//   out[r][c] = digits[src[rows[r]][cols[c]]]   where src = transpose ? in^T : in
+// ------------------------
+
+struct Transform {
+    std::array<uint8_t, SIZE + 1> digits;  // digits[EMPTY] is always EMPTY
+    std::array<uint8_t, SIZE> rows;        // new row r comes from old row rows[r]
+    std::array<uint8_t, SIZE> cols;        // new col c comes from old col cols[c]
+    bool transpose;
+};
+
+// Transform flattened into a per-cell gather table, applying it is one load per cell
+struct CellMap {
+    std::array<uint8_t, CELLS> source;
+    std::array<uint8_t, SIZE + 1> digits;
+};
+
+// 9! digit relabellings * (3!)^8 line permutations * 2 transpositions
+constexpr uint64_t TRANSFORM_COUNT = 362880ULL * 1679616ULL * 2ULL;
+
+Transform identity();
+
+Transform randomTransform(std::mt19937& rng);
+
+// Enumerates the group: every index in [0, TRANSFORM_COUNT) decodes to a distinct transform
+Transform transformFromIndex(uint64_t index);
+
+Transform inverse(const Transform& transform);
+
+CellMap compile(const Transform& transform);
+
+// out must not alias in
+void apply(const CellMap& map, const FlatGrid& in, FlatGrid& out);
+
+void apply(const CellMap& map, const FlatGivens& in, FlatGivens& out);
+
+void apply(const Transform& transform, std::vector<std::vector<int>>& grid, std::vector<std::vector<bool>>& givens);
+
+}  // namespace symmetry
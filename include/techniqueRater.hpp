@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "flatGrid.hpp"
+
+namespace rater {
+
+// ------------------------
+// Human-style grading: the puzzle is solved with a ladder of logical techniques, always
+// retrying the easiest one after any progress, and graded by the hardest technique it needed.
+// No guessing: a puzzle the ladder cannot finish is rated beyond it (tier 4).
+// ------------------------
+
+// In ladder order, easiest first
+enum class Technique : uint8_t {
+    HiddenSingle,
+    NakedSingle,
+    LockedCandidates,  // pointing and claiming
+    NakedPair,
+    HiddenPair,
+    NakedTriple,
+    HiddenTriple,
+    XWing,
+    XYWing,
+    Swordfish,
+    SimpleColoring,  // single-digit conjugate chains
+    Count
+};
+
+constexpr int TECHNIQUE_COUNT = static_cast<int>(Technique::Count);
+
+// 0 Easy: singles, 1 Medium: locked candidates and pairs, 2 Hard: triples, X-wing, XY-wing,
+// 3 Evil: swordfish and chains, 4: stalls the ladder
+constexpr int RATING_TIERS = 5;
+
+struct Rating {
+    bool solved;        // the ladder filled every cell
+    Technique hardest;  // meaningless if no technique was needed (full grid)
+    int tier;
+    int score;  // sum of per-step weights, separates puzzles within a tier
+    std::array<uint16_t, TECHNIQUE_COUNT> uses;
+};
+
+// Expects a puzzle with a unique solution; contradictions just stop the ladder (not solved)
+Rating rate(const FlatGrid& puzzle);
+
+int tierOf(Technique technique);
+
+const char* techniqueName(Technique technique);
+
+// "Easy", "Medium", "Hard", "Evil", "Impossible"
+const char* tierName(int tier);
+
+}  // namespace rater
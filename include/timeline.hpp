@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace timeline {
+
+// ------------------------
+// Timeline zones, compiled in with -DSUDOKUX_ENABLE_TIMELINE. A Zone times its own scope as
+// one event on the calling thread while a recording runs; stop() writes every thread's events
+// as Chrome trace JSON, for chrome://tracing or ui.perfetto.dev. In a default build zones are
+// empty and compile away. Outside a recording a zone costs one relaxed load.
+// ------------------------
+
+#ifdef SUDOKUX_ENABLE_TIMELINE
+constexpr bool ENABLED = true;
+#else
+constexpr bool ENABLED = false;
+#endif
+
+namespace detail {
+inline std::atomic<bool> recording{false};
+
+inline uint64_t now() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+void record(const char* name, uint64_t start, uint64_t end);
+}  // namespace detail
+
+// name must outlive the recording, i.e. a string literal
+class Zone {
+   private:
+    static constexpr uint64_t IDLE = ~uint64_t(0);
+
+    const char* name;
+    uint64_t start = IDLE;
+
+   public:
+    explicit Zone(const char* name) : name(name) {
+        if constexpr (ENABLED) {
+            if (detail::recording.load(std::memory_order_relaxed)) start = detail::now();
+        }
+    }
+
+    ~Zone() {
+        if constexpr (ENABLED) {
+            if (start != IDLE) detail::record(name, start, detail::now());
+        }
+    }
+
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+};
+
+// Labels the calling thread's track, kept across recordings
+void nameThread(const char* name);
+
+// Drops the events of any earlier recording and starts a new one
+void start();
+
+// Ends the recording and writes it to path, false if the file could not be written
+bool stop(const std::string& path);
+
+}  // namespace timeline
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "boardWidget.hpp"
+#include "solverTrace.hpp"
+
+// ------------------------
+// Step-by-step replay of a recorded solver trace. The board starts where the held events
+// start and advances at an adjustable number of steps per second; the cell changed last is
+// highlighted, dark blue for a placement and red for a removal.
+// ------------------------
+
+class TraceReplay {
+   private:
+    const trace::Recorder* recorder = nullptr;
+    std::vector<uint8_t> startCells;     // row-major, before the first held event
+    std::vector<std::vector<int>> grid;  // current replay board
+    std::vector<std::vector<bool>> givens;
+    std::array<uint8_t, MAX_BOARD_CELLS> styles{};
+
+    size_t position = 0;  // events applied so far
+    int lastCell = -1;
+    trace::Action lastAction = trace::Action::Place;
+    bool playing = false;
+    float stepsPerSecond = 50.0f;
+    double owed = 0.0;  // fractional steps carried between frames
+
+    void rewind();
+    void advance(size_t steps);
+
+   public:
+    // solved is the board the traced search returned, the replay ends on it
+    void start(const trace::Recorder& recorder, const std::vector<std::vector<int>>& solved, const std::vector<std::vector<bool>>& givens);
+
+    void stop() { recorder = nullptr; }
+    bool active() const { return recorder != nullptr; }
+    bool animating() const { return active() && playing; }
+
+    // transport controls and the board, call once per frame
+    void render();
+};
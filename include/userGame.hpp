@@ -4,15 +4,19 @@
 
 #include "constants.hpp"
 #include "gameUI.hpp"
+#include "playerBoard.hpp"
 
-void renderPuzzleForUser(std::vector<std::vector<int>>& grid, const std::vector<std::vector<bool>>& givens, bool& puzzleSolved, float& elapsedTime);
+// Interactive play. Every edit goes through player so its conflict counters stay in step
+// with grid; call player.reset(grid) after loading a new puzzle.
 
-void renderInputGrid(std::vector<std::vector<int>>& grid, const std::vector<std::vector<bool>>& givens);
+// once player.solved() the whole board is drawn as givens
+void renderPuzzleForUser(const std::vector<std::vector<int>>& grid, const std::vector<std::vector<bool>>& givens, const PlayerBoard& player);
 
-void renderClearButton(std::vector<std::vector<int>>& grid);
+void renderInputGrid(std::vector<std::vector<int>>& grid, const std::vector<std::vector<bool>>& givens, PlayerBoard& player);
 
-void renderRestartButton(std::vector<std::vector<int>>& grid, const std::vector<std::vector<bool>>& givens);
+void renderClearButton(std::vector<std::vector<int>>& grid, const std::vector<std::vector<bool>>& givens, PlayerBoard& player);
 
+void renderRestartButton(std::vector<std::vector<int>>& grid, const std::vector<std::vector<bool>>& givens, PlayerBoard& player);
 
 /*
 
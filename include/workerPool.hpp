@@ -0,0 +1,38 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ------------------------
+// Fixed set of threads draining one FIFO of jobs. Used by the headless front ends to run
+// engine calls off their I/O thread.
+// ------------------------
+
+class WorkerPool {
+   private:
+    std::vector<std::thread> threads;
+    std::deque<std::function<void()>> jobs;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping = false;
+
+    void workerLoop();
+
+   public:
+    // threadCount <= 0 uses one thread per hardware thread
+    explicit WorkerPool(int threadCount);
+
+    // finishes the jobs already queued, then joins
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void submit(std::function<void()> job);
+
+    int size() const { return static_cast<int>(threads.size()); }
+};
@@ -4,18 +4,22 @@
 #include <iostream>
 // #include <thread>
 
+#include "timeline.hpp"
+
 namespace backtracking {
 
 bool isValid(int row, int col, int num, std::vector<std::vector<int>>& grid) {
-    int boxRowStart = row - (row % 3);
-    int boxColStart = col - (col % 3);
+    int size = static_cast<int>(grid.size());
+    BoxShape box = boxShapeOf(size);
+    int boxRowStart = row - (row % box.rows);
+    int boxColStart = col - (col % box.cols);
 
-    for (int i = 0; i < SIZE; i++) {
+    for (int i = 0; i < size; i++) {
         if (grid[row][i] == num || grid[i][col] == num) return false;
     }
 
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 3; j++) {
+    for (int i = 0; i < box.rows; i++) {
+        for (int j = 0; j < box.cols; j++) {
             if (grid[boxRowStart + i][boxColStart + j] == num) return false;
         }
     }
@@ -23,25 +27,135 @@ bool isValid(int row, int col, int num, std::vector<std::vector<int>>& grid) {
     return true;
 }
 
-bool solver(int row, int col, std::vector<std::vector<int>>& grid) {
-    if (row == SIZE) return true;
-    if (col == SIZE) return solver(row + 1, 0, grid);
-    if (grid[row][col] != EMPTY) return solver(row, col + 1, grid);
+void solve(std::vector<std::vector<int>>& grid, trace::Recorder* trace) {
+    withBoard(static_cast<int>(grid.size()), [&](auto board) {
+        board = decltype(board)::fromGrid(grid);
+        if (!solve(board, trace)) {
+            std::cout << "No solution exists!\n";
+            return;
+        }
+        board.toGrid(grid);
+    });
+}
+
+template <class B>
+bool isValid(const B& board, int row, int col, int num) {
+    int boxRowStart = row - (row % B::boxRows);
+    int boxColStart = col - (col % B::boxCols);
+
+    for (int i = 0; i < B::size; i++) {
+        if (board.at(row, i) == num || board.at(i, col) == num) return false;
+    }
+
+    for (int i = 0; i < B::boxRows; i++) {
+        for (int j = 0; j < B::boxCols; j++) {
+            if (board.at(boxRowStart + i, boxColStart + j) == num) return false;
+        }
+    }
+
+    return true;
+}
+
+namespace {
+
+// TRACED is a template flag so the untraced search compiles exactly as before
+template <class B, bool TRACED>
+bool search(B& board, int cell, trace::Recorder* trace) {
+    while (cell < B::cellCount && board.cells[cell] != EMPTY) cell++;
+    if (cell == B::cellCount) return true;
 
-    for (int num = 1; num <= SIZE; num++) {
-        if (isValid(row, col, num, grid)) {
-            grid[row][col] = num;
-            if (solver(row, col + 1, grid)) return true;
-            grid[row][col] = EMPTY;
+    int row = B::rowOf(cell);
+    int col = B::colOf(cell);
+    for (int num = 1; num <= B::size; num++) {
+        if (isValid(board, row, col, num)) {
+            board.cells[cell] = num;
+            stats::enter();
+            if constexpr (TRACED) trace->place(cell, num);
+            if (search<B, TRACED>(board, cell + 1, trace)) return true;
+            board.cells[cell] = EMPTY;
+            stats::leave();
+            if constexpr (TRACED) trace->remove(cell, num);
         }
     }
 
     return false;
 }
 
-void solve(std::vector<std::vector<int>>& grid) {
-    if (!solver(0, 0, grid)) {
-        std::cout << "No solution exists!\n";
+// ------------------------
+// Resumable search: the recursion above unrolled over the list of empty cells. The cells
+// below depth hold their current digit; a step moves the deepest cell to its next valid
+// digit, or clears it and backs up when none is left.
+// ------------------------
+
+template <class B>
+class SearchTask : public SolveTask {
+   private:
+    B board;
+    std::vector<int> holes;  // empty cells in search order
+    int depth = 0;           // holes[0..depth) hold a digit
+    bool finished = false;
+
+   public:
+    explicit SearchTask(const std::vector<std::vector<int>>& grid) : board(B::fromGrid(grid)) {
+        for (int cell = 0; cell < B::cellCount; cell++) {
+            if (board.cells[cell] == EMPTY) holes.push_back(cell);
+        }
+    }
+
+    bool run(long steps) override {
+        for (; !finished && steps > 0; steps--) {
+            if (depth == static_cast<int>(holes.size())) {
+                finished = true;
+                break;
+            }
+
+            int cell = holes[depth];
+            int num = board.cells[cell] + 1;
+            if (board.cells[cell] != EMPTY) stats::leave();
+            board.cells[cell] = EMPTY;
+            while (num <= B::size && !isValid(board, B::rowOf(cell), B::colOf(cell), num)) num++;
+
+            if (num <= B::size) {
+                board.cells[cell] = num;
+                stats::enter();
+                depth++;
+            } else if (depth == 0) {
+                finished = true;  // exhausted, every hole is EMPTY again
+                std::cout << "No solution exists!\n";
+            } else {
+                depth--;
+            }
+        }
+        return finished;
     }
+
+    void result(std::vector<std::vector<int>>& grid) const override { board.toGrid(grid); }
+};
+
+}  // namespace
+
+std::unique_ptr<SolveTask> makeSolveTask(const std::vector<std::vector<int>>& grid) {
+    std::unique_ptr<SolveTask> task;
+    withBoard(static_cast<int>(grid.size()), [&](auto board) { task = std::make_unique<SearchTask<decltype(board)>>(grid); });
+    return task;
+}
+
+template <class B>
+bool solver(B& board, int cell) {
+    return search<B, false>(board, cell, nullptr);
 }
-}  // namespace backtracking
\ No newline at end of file
+
+template <class B>
+bool solve(B& board, trace::Recorder* trace) {
+    timeline::Zone zone("search");
+    return trace ? search<B, true>(board, 0, trace) : search<B, false>(board, 0, nullptr);
+}
+
+#define INSTANTIATE_BACKTRACKING(B)                             \
+    template bool isValid<B>(const B&, int, int, int);          \
+    template bool solver<B>(B&, int);                           \
+    template bool solve<B>(B&, trace::Recorder*);
+SUDOKUX_FOR_EACH_BOARD(INSTANTIATE_BACKTRACKING)
+#undef INSTANTIATE_BACKTRACKING
+
+}  // namespace backtracking
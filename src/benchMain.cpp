@@ -0,0 +1,198 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "backtracking.hpp"
+#include "board.hpp"
+#include "dlxBoard.hpp"
+#include "flatGrid.hpp"
+#include "generatePuzzle.hpp"
+#include "perfCounters.hpp"
+#include "puzzleIO.hpp"
+#include "timeline.hpp"
+
+// ------------------------
+// sudokuBench: throughput of the classic-size engines over one puzzle set.
+//   sudokuBench [--puzzles FILE] [--count N] [--difficulty 0-4] [--rounds R] [--perf] [--timeline FILE]
+// Puzzles come from FILE (puzzleIO format) or are generated (count, difficulty). Every
+// algorithm runs over the whole set R times and the fastest round is reported as puzzles/s;
+// with --perf, that round's hardware counters are printed per puzzle next to it. --timeline
+// writes a Chrome trace of generation and every round (SUDOKUX_ENABLE_TIMELINE builds).
+// ------------------------
+
+namespace {
+
+struct Algorithm {
+    const char* name;
+    bool (*run)(const FlatGrid& puzzle);  // false if the puzzle was not solved (or not unique)
+};
+
+const Algorithm ALGORITHMS[] = {
+    {"backtracking",
+     [](const FlatGrid& puzzle) {
+         ClassicBoard board;
+         board.cells = puzzle;
+         return backtracking::solve(board);
+     }},
+    {"dlx",
+     [](const FlatGrid& puzzle) {
+         ClassicBoard board;
+         board.cells = puzzle;
+         return DLX::solve(board);
+     }},
+    // the generator's uniqueness check
+    {"dlx-unique",
+     [](const FlatGrid& puzzle) {
+         ClassicBoard board;
+         board.cells = puzzle;
+         return DLX::countSolutions(board, 2) == 1;
+     }},
+};
+
+struct Round {
+    double seconds = 0;
+    size_t solved = 0;
+    perf::Reading counters;
+};
+
+Round runRound(const Algorithm& algorithm, const std::vector<FlatGrid>& puzzles, perf::Counters* counters) {
+    Round round;
+    auto start = std::chrono::steady_clock::now();
+    if (counters) counters->start();
+    for (const FlatGrid& puzzle : puzzles) round.solved += algorithm.run(puzzle);
+    if (counters) {
+        counters->stop();
+        round.counters = counters->read();
+    }
+    round.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return round;
+}
+
+// one counter per puzzle, "n/a" when the event could not be opened
+void printCounter(const perf::Reading& reading, int counter, size_t puzzles) {
+    if (reading.valid[counter]) {
+        std::printf(" %12.0f", reading.values[counter] / puzzles);
+    } else {
+        std::printf(" %12s", "n/a");
+    }
+}
+
+void printUsage(const char* program) {
+    std::cerr << "usage: " << program << " [--puzzles FILE] [--count N] [--difficulty D] [--rounds R] [--perf] [--timeline FILE]\n"
+              << "  --puzzles     one puzzle per line, instead of generating them\n"
+              << "  --count       puzzles to generate (default 100)\n"
+              << "  --difficulty  0 Easy .. 4 Impossible for generated puzzles (default 2)\n"
+              << "  --rounds      passes over the set per algorithm, the fastest is reported (default 5)\n"
+              << "  --perf        hardware counters per puzzle (Linux perf_event_open)\n"
+              << "  --timeline    Chrome trace JSON of the run\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string puzzleFile;
+    int count = 100;
+    int difficulty = 2;
+    int rounds = 5;
+    bool usePerf = false;
+    std::string timelineFile;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--puzzles") == 0 && hasValue) {
+            puzzleFile = argv[++i];
+        } else if (std::strcmp(argv[i], "--count") == 0 && hasValue) {
+            count = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--difficulty") == 0 && hasValue) {
+            difficulty = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--rounds") == 0 && hasValue) {
+            rounds = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--perf") == 0) {
+            usePerf = true;
+        } else if (std::strcmp(argv[i], "--timeline") == 0 && hasValue) {
+            timelineFile = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+    if (count <= 0 || rounds <= 0 || difficulty < 0 || difficulty > IMPOSSIBLE_DIFFICULTY) {
+        printUsage(argv[0]);
+        return 2;
+    }
+    if (!timelineFile.empty()) {
+        if (!timeline::ENABLED) {
+            std::cerr << "--timeline needs a build configured with -DSUDOKUX_ENABLE_TIMELINE=ON\n";
+            return 2;
+        }
+        timeline::nameThread("bench");
+        timeline::start();
+    }
+
+    // stdout carries the report; the generators' progress messages go to stderr instead
+    std::cout.rdbuf(std::cerr.rdbuf());
+
+    std::vector<FlatGrid> puzzles;
+    if (!puzzleFile.empty()) {
+        puzzleIO::MappedFile file;
+        if (!file.open(puzzleFile)) {
+            std::cerr << "cannot read " << puzzleFile << "\n";
+            return 1;
+        }
+        puzzleIO::PuzzleReader reader(file);
+        FlatGrid grid;
+        while (reader.next(grid)) puzzles.push_back(grid);
+        if (reader.skipped()) std::cerr << "skipped " << reader.skipped() << " malformed lines\n";
+    } else {
+        for (int i = 0; i < count; i++) {
+            Puzzle puzzle = difficulty < IMPOSSIBLE_DIFFICULTY ? makeRatedPuzzle(difficulty) : makePuzzle(difficulty);
+            puzzles.push_back(flatten(puzzle.grid));
+        }
+    }
+    if (puzzles.empty()) {
+        std::cerr << "no puzzles\n";
+        return 1;
+    }
+
+    perf::Counters counters;
+    if (usePerf && !counters.available()) std::cerr << "perf_event_open: no hardware counters available, reporting times only\n";
+
+    std::printf("%zu puzzles, best of %d rounds\n", puzzles.size(), rounds);
+    std::printf("%-14s %12s %12s %8s", "algorithm", "puzzles/s", "ns/puzzle", "solved");
+    if (usePerf) {
+        for (int c = 0; c < perf::COUNTER_COUNT; c++) std::printf(" %12s", perf::counterName(c));
+        std::printf(" %6s", "IPC");
+    }
+    std::printf("\n");
+
+    for (const Algorithm& algorithm : ALGORITHMS) {
+        Round best;
+        for (int r = 0; r < rounds; r++) {
+            timeline::Zone zone(algorithm.name);
+            Round round = runRound(algorithm, puzzles, usePerf ? &counters : nullptr);
+            if (r == 0 || round.seconds < best.seconds) best = round;
+        }
+
+        std::printf("%-14s %12.0f %12.0f %8zu", algorithm.name, puzzles.size() / best.seconds, best.seconds * 1e9 / puzzles.size(), best.solved);
+        if (usePerf) {
+            for (int c = 0; c < perf::COUNTER_COUNT; c++) printCounter(best.counters, c, puzzles.size());
+            const perf::Reading& reading = best.counters;
+            if (reading.valid[perf::CYCLES] && reading.valid[perf::INSTRUCTIONS] && reading.values[perf::CYCLES] > 0) {
+                std::printf(" %6.2f", reading.values[perf::INSTRUCTIONS] / reading.values[perf::CYCLES]);
+            } else {
+                std::printf(" %6s", "n/a");
+            }
+        }
+        std::printf("\n");
+    }
+
+    if (!timelineFile.empty() && !timeline::stop(timelineFile)) {
+        std::cerr << "cannot write " << timelineFile << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "boardWidget.hpp"
+
+#include <algorithm>
+
+#include "board.hpp"
+#include "gameUI.hpp"
+
+namespace {
+
+constexpr const char* DIGIT_GLYPHS[MAX_BOARD_SIDE + 1] = {"",   "1",  "2",  "3",  "4",  "5",  "6",  "7",  "8",  "9",  "10", "11", "12",
+                                                          "13", "14", "15", "16", "17", "18", "19", "20", "21", "22", "23", "24", "25"};
+
+constexpr float BOX_GAP = 15.0f;
+
+// offset of cell index i along one axis, boxes of span cells
+float cellOffset(int i, int span, const BoardLayout& layout) {
+    int boxesBefore = i / span;
+    return i * layout.cellSize + (i - boxesBefore) * layout.cellGap + boxesBefore * layout.boxGap;
+}
+
+// cell index under offset along one axis, -1 in a gap or outside
+int cellAt(float offset, int size, int span, const BoardLayout& layout) {
+    for (int i = 0; i < size; i++) {
+        float start = cellOffset(i, span, layout);
+        if (offset < start) return -1;
+        if (offset < start + layout.cellSize) return i;
+    }
+    return -1;
+}
+
+}  // namespace
+
+const char* digitGlyph(int digit) { return digit > 0 && digit <= MAX_BOARD_SIDE ? DIGIT_GLYPHS[digit] : DIGIT_GLYPHS[0]; }
+
+BoardLayout boardLayout(int size, float windowWidth) {
+    // 50px cells up to 9x9, larger boards shrink to fit the window
+    const BoxShape box = boxShapeOf(size);
+    const int boxesPerRow = box.rows;
+
+    BoardLayout layout;
+    layout.cellGap = ImGui::GetStyle().ItemSpacing.x;
+    layout.boxGap = BOX_GAP;
+    float available = windowWidth * 0.9f - (size - boxesPerRow) * layout.cellGap - (boxesPerRow - 1) * layout.boxGap;
+    layout.cellSize = std::max(18.0f, std::min(50.0f, available / size));
+    layout.width = cellOffset(size - 1, box.cols, layout) + layout.cellSize;
+    return layout;
+}
+
+bool drawBoard(const char* id, const std::vector<std::vector<int>>& grid, const uint8_t* styles, int& clickedRow, int& clickedCol) {
+    const int size = static_cast<int>(grid.size());
+    const BoxShape box = boxShapeOf(size);
+    const BoardLayout layout = boardLayout(size, ImGui::GetWindowWidth());
+    const float height = cellOffset(size - 1, box.rows, layout) + layout.cellSize;
+
+    ImGui::SetCursorPosX((ImGui::GetWindowWidth() - layout.width) * 0.5f);
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    bool clicked = ImGui::InvisibleButton(id, ImVec2(layout.width, height));
+    bool hovered = ImGui::IsItemHovered();
+
+    const ImVec2 mouse = ImGui::GetIO().MousePos;
+    int hoverRow = hovered ? cellAt(mouse.y - origin.y, size, box.rows, layout) : -1;
+    int hoverCol = hovered ? cellAt(mouse.x - origin.x, size, box.cols, layout) : -1;
+    if (hoverRow < 0 || hoverCol < 0) hoverRow = hoverCol = -1;
+
+    const ImGuiStyle& style = ImGui::GetStyle();
+    const ImU32 fills[] = {
+        ImGui::GetColorU32(ImGuiCol_Button),
+        ImGui::GetColorU32(RGBA(0, 191, 255, 0.8)),  // Light Blue
+        ImGui::GetColorU32(RGBA(0, 84, 251, 0.8)),   // Dark Blue
+        ImGui::GetColorU32(RGBA(255, 0, 0, 0.8)),    // Red
+    };
+    const ImU32 hoverFill = ImGui::GetColorU32(ImGuiCol_ButtonHovered);
+    const ImU32 textColour = ImGui::GetColorU32(ImGuiCol_Text);
+
+    // every cell goes into one draw command: same texture, same clip rect
+    ImDrawList* draw = ImGui::GetWindowDrawList();
+    for (int row = 0; row < size; row++) {
+        const float y = origin.y + cellOffset(row, box.rows, layout);
+        for (int col = 0; col < size; col++) {
+            const float x = origin.x + cellOffset(col, box.cols, layout);
+            const uint8_t cellStyle = styles[row * size + col];
+            const ImVec2 min(x, y), max(x + layout.cellSize, y + layout.cellSize);
+
+            bool isHovered = row == hoverRow && col == hoverCol && cellStyle == CELL_NORMAL;
+            draw->AddRectFilled(min, max, isHovered ? hoverFill : fills[cellStyle], style.FrameRounding);
+
+            const char* glyph = digitGlyph(grid[row][col]);
+            if (*glyph == '\0') continue;
+            const ImVec2 textSize = ImGui::CalcTextSize(glyph);
+            draw->AddText(ImVec2(x + (layout.cellSize - textSize.x) * 0.5f, y + (layout.cellSize - textSize.y) * 0.5f), textColour, glyph);
+        }
+    }
+
+    if (!clicked || hoverRow < 0) return false;
+    clickedRow = hoverRow;
+    clickedCol = hoverCol;
+    return true;
+}
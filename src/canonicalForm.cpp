@@ -0,0 +1,301 @@
+#include "canonicalForm.hpp"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <vector>
+
+namespace canonical {
+
+namespace {
+
+// Partial candidate while building the minimal grid row by row
+struct SearchState {
+    std::array<uint8_t, SIZE> rows;        // source rows chosen so far
+    std::array<uint8_t, SIZE> cols;        // full column order, fixed by row 0
+    std::array<uint8_t, SIZE + 1> labels;  // digit -> relabelled digit, 0 = not seen yet
+    uint8_t nextLabel;
+    uint8_t transpose;
+};
+
+// scratch larger than this is released after the call instead of kept for the next one
+constexpr size_t KEPT_SCRATCH_STATES = 4096;
+
+// Orders the rows of one stack / one band
+constexpr uint8_t LINE_PERMUTATIONS[6][BOX_SIZE] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+
+// -1 / 0 / +1 comparison of a candidate row against the best row seen at this level.
+// Relabels while comparing and bails out as soon as the candidate is known to be larger.
+int relabelRow(const uint8_t* source, const SearchState& state, std::array<uint8_t, SIZE + 1>& labels, uint8_t& nextLabel, uint8_t* out, const uint8_t* best, bool haveBest) {
+    int order = haveBest ? 0 : -1;
+    for (int c = 0; c < SIZE; c++) {
+        uint8_t digit = source[state.cols[c]];
+        uint8_t label = EMPTY;
+        if (digit != EMPTY) {
+            if (labels[digit] == 0) labels[digit] = nextLabel++;
+            label = labels[digit];
+        }
+        out[c] = label;
+
+        if (order == 0 && label != best[c]) {
+            if (label > best[c]) return 1;
+            order = -1;
+        }
+    }
+    return order;
+}
+
+// Row 0 after relabelling only depends on where its holes are (givens in a row are distinct and
+// are relabelled 1, 2, 3... left to right), so the best first rows are the ones whose stacks,
+// sorted by hole count, have the most holes; the column orders that realize it put those stacks
+// first and the holes first inside every stack.
+// Stops adding orders once MAX_TIE_STATES are seeded and sets truncated.
+void seedFirstRow(const FlatGrid (&sources)[2], std::vector<SearchState>& states, std::array<uint8_t, SIZE>& bestRow, bool& truncated) {
+    int bestKey = -1;
+    int keys[2][SIZE];
+    int holes[2][SIZE][BOX_SIZE];
+
+    for (int t = 0; t < 2; t++) {
+        for (int r = 0; r < SIZE; r++) {
+            for (int s = 0; s < BOX_SIZE; s++) {
+                holes[t][r][s] = 0;
+                for (int i = 0; i < BOX_SIZE; i++) holes[t][r][s] += sources[t][r * SIZE + s * BOX_SIZE + i] == EMPTY;
+            }
+            int sorted[BOX_SIZE] = {holes[t][r][0], holes[t][r][1], holes[t][r][2]};
+            std::sort(sorted, sorted + BOX_SIZE, std::greater<int>());
+            keys[t][r] = sorted[0] * 16 + sorted[1] * 4 + sorted[2];
+            bestKey = std::max(bestKey, keys[t][r]);
+        }
+    }
+
+    states.clear();
+    for (int t = 0; t < 2; t++) {
+        for (int r = 0; r < SIZE; r++) {
+            if (keys[t][r] != bestKey) continue;
+
+            const uint8_t* source = &sources[t][r * SIZE];
+
+            // per stack: hole columns first, then given columns, each group in every order (at most 3! orders)
+            std::array<uint8_t, BOX_SIZE> stackOrders[BOX_SIZE][6];
+            int orderCount[BOX_SIZE] = {};
+            for (int s = 0; s < BOX_SIZE; s++) {
+                uint8_t emptyCols[BOX_SIZE], filledCols[BOX_SIZE];
+                int emptyCount = 0, filledCount = 0;
+                for (int i = 0; i < BOX_SIZE; i++) {
+                    uint8_t col = s * BOX_SIZE + i;
+                    if (source[col] == EMPTY)
+                        emptyCols[emptyCount++] = col;
+                    else
+                        filledCols[filledCount++] = col;
+                }
+                do {
+                    do {
+                        std::array<uint8_t, BOX_SIZE>& order = stackOrders[s][orderCount[s]++];
+                        std::copy(emptyCols, emptyCols + emptyCount, order.begin());
+                        std::copy(filledCols, filledCols + filledCount, order.begin() + emptyCount);
+                    } while (std::next_permutation(filledCols, filledCols + filledCount));
+                } while (std::next_permutation(emptyCols, emptyCols + emptyCount));
+            }
+
+            for (const auto& stackPerm : LINE_PERMUTATIONS) {
+                bool nonIncreasing = holes[t][r][stackPerm[0]] >= holes[t][r][stackPerm[1]] && holes[t][r][stackPerm[1]] >= holes[t][r][stackPerm[2]];
+                if (!nonIncreasing) continue;
+
+                for (int a = 0; a < orderCount[stackPerm[0]]; a++) {
+                    for (int b = 0; b < orderCount[stackPerm[1]]; b++) {
+                        for (int c = 0; c < orderCount[stackPerm[2]]; c++) {
+                            if (states.size() == MAX_TIE_STATES) {
+                                truncated = true;
+                                continue;
+                            }
+                            const auto& first = stackOrders[stackPerm[0]][a];
+                            const auto& second = stackOrders[stackPerm[1]][b];
+                            const auto& third = stackOrders[stackPerm[2]][c];
+                            SearchState state;
+                            state.transpose = t;
+                            state.rows[0] = r;
+                            std::copy(first.begin(), first.end(), state.cols.begin());
+                            std::copy(second.begin(), second.end(), state.cols.begin() + BOX_SIZE);
+                            std::copy(third.begin(), third.end(), state.cols.begin() + 2 * BOX_SIZE);
+                            state.labels.fill(0);
+                            state.nextLabel = 1;
+                            relabelRow(source, state, state.labels, state.nextLabel, bestRow.data(), nullptr, false);
+                            states.push_back(state);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+}  // namespace
+
+CanonicalForm canonicalize(const FlatGrid& puzzle) {
+    FlatGrid sources[2];
+    sources[0] = puzzle;
+    for (int r = 0; r < SIZE; r++) {
+        for (int c = 0; c < SIZE; c++) sources[1][r * SIZE + c] = puzzle[c * SIZE + r];
+    }
+
+    // scratch buffers are reused across calls, canonicalizing is typically done in bulk
+    thread_local std::vector<SearchState> current, next;
+
+    CanonicalForm result;
+    bool truncated = false;
+    std::array<uint8_t, SIZE> bestRow;
+    seedFirstRow(sources, current, bestRow, truncated);
+    std::copy(bestRow.begin(), bestRow.end(), result.grid.begin());
+
+    for (int k = 1; k < SIZE; k++) {
+        next.clear();
+        bool haveBest = false;
+
+        for (const SearchState& state : current) {
+            // rows allowed at position k: the rest of the current band, or any row of an unused band
+            uint8_t options[SIZE];
+            int optionCount = 0;
+            int bandStart = k - k % BOX_SIZE;
+            if (k % BOX_SIZE != 0) {
+                int band = state.rows[bandStart] / BOX_SIZE;
+                for (int i = 0; i < BOX_SIZE; i++) {
+                    uint8_t row = band * BOX_SIZE + i;
+                    if (std::find(state.rows.begin() + bandStart, state.rows.begin() + k, row) == state.rows.begin() + k) options[optionCount++] = row;
+                }
+            } else {
+                for (int band = 0; band < BOX_SIZE; band++) {
+                    bool used = false;
+                    for (int b = 0; b < k; b += BOX_SIZE) used |= state.rows[b] / BOX_SIZE == band;
+                    if (used) continue;
+                    for (int i = 0; i < BOX_SIZE; i++) options[optionCount++] = band * BOX_SIZE + i;
+                }
+            }
+
+            for (int o = 0; o < optionCount; o++) {
+                SearchState candidate = state;
+                uint8_t row[SIZE];
+                int order = relabelRow(&sources[state.transpose][options[o] * SIZE], state, candidate.labels, candidate.nextLabel, row, bestRow.data(), haveBest);
+                if (order > 0) continue;
+                if (order < 0) {
+                    std::copy(row, row + SIZE, bestRow.begin());
+                    haveBest = true;
+                    next.clear();
+                } else if (next.size() == MAX_TIE_STATES) {
+                    truncated = true;
+                    continue;
+                }
+                candidate.rows[k] = options[o];
+                next.push_back(candidate);
+            }
+        }
+
+        std::copy(bestRow.begin(), bestRow.end(), result.grid.begin() + k * SIZE);
+        std::swap(current, next);
+    }
+
+    // any surviving state produces the same grid, report the first one as the transform
+    const SearchState& winner = current.front();
+    symmetry::Transform& transform = result.transform;
+    transform.transpose = winner.transpose;
+    transform.rows = winner.rows;
+    transform.cols = winner.cols;
+
+    // digits missing from the puzzle take the unused labels so the relabelling stays a permutation
+    uint8_t nextLabel = winner.nextLabel;
+    transform.digits[EMPTY] = EMPTY;
+    for (int d = 1; d <= SIZE; d++) {
+        transform.digits[d] = winner.labels[d] != 0 ? winner.labels[d] : nextLabel++;
+    }
+    result.exact = !truncated;
+
+    for (auto* scratch : {&current, &next}) {
+        if (scratch->capacity() > KEPT_SCRATCH_STATES) std::vector<SearchState>().swap(*scratch);
+    }
+    return result;
+}
+
+// ------------------------
+// Hashing: cells packed 4 bits each, folded through a 64-bit finalizer per word
+// ------------------------
+
+namespace {
+
+uint64_t mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+uint64_t hashWithSeed(const FlatGrid& grid, uint64_t seed) {
+    uint64_t hash = seed;
+    for (int i = 0; i < CELLS; i += 16) {
+        uint64_t word = 0;
+        for (int j = i; j < std::min(i + 16, CELLS); j++) word = (word << 4) | grid[j];
+        hash = mix(hash ^ word) + 0x9e3779b97f4a7c15ULL;
+    }
+    return mix(hash ^ CELLS);
+}
+
+}  // namespace
+
+uint64_t hash64(const FlatGrid& grid) { return hashWithSeed(grid, 0x243f6a8885a308d3ULL); }
+
+Hash128 hash128(const FlatGrid& grid) { return {hashWithSeed(grid, 0x13198a2e03707344ULL), hashWithSeed(grid, 0xa4093822299f31d0ULL)}; }
+
+Hash128 canonicalHash(const FlatGrid& puzzle) { return hash128(canonicalize(puzzle).grid); }
+
+// ------------------------
+// Invariants and deduplication
+// ------------------------
+
+uint64_t invariantHash(const FlatGrid& puzzle) {
+    int rowCounts[SIZE] = {}, colCounts[SIZE] = {}, boxCounts[SIZE] = {};
+    for (int i = 0; i < CELLS; i++) {
+        if (puzzle[i] == EMPTY) continue;
+        rowCounts[i / SIZE]++;
+        colCounts[i % SIZE]++;
+        boxCounts[(i / SIZE / BOX_SIZE) * BOX_SIZE + (i % SIZE) / BOX_SIZE]++;
+    }
+
+    // every given is described by the givens in its row, col and box; transposition swaps the
+    // first two so they are taken unordered, and sums make the result independent of cell order
+    uint64_t digitSums[SIZE + 1] = {};
+    for (int i = 0; i < CELLS; i++) {
+        if (puzzle[i] == EMPTY) continue;
+        int row = rowCounts[i / SIZE];
+        int col = colCounts[i % SIZE];
+        int box = boxCounts[(i / SIZE / BOX_SIZE) * BOX_SIZE + (i % SIZE) / BOX_SIZE];
+        digitSums[puzzle[i]] += mix((std::min(row, col) * 16 + std::max(row, col)) * 16 + box + 1);
+    }
+
+    // digits are interchangeable, so fold their descriptions order-independently as well
+    uint64_t hash = 0;
+    for (int d = 1; d <= SIZE; d++) hash += mix(digitSums[d] ^ 0x9e3779b97f4a7c15ULL);
+    return mix(hash);
+}
+
+bool Deduplicator::insert(const FlatGrid& puzzle) {
+    std::vector<Entry>& bucket = buckets[invariantHash(puzzle)];
+
+    if (!bucket.empty()) {
+        Hash128 canonical = canonicalHash(puzzle);
+        for (Entry& entry : bucket) {
+            if (!entry.hashed) {
+                entry.canonical = canonicalHash(entry.puzzle);
+                entry.hashed = true;
+            }
+            if (entry.canonical == canonical) return false;
+        }
+        bucket.push_back({puzzle, true, canonical});
+    } else {
+        bucket.push_back({puzzle, false, {}});
+    }
+
+    count++;
+    return true;
+}
+
+}  // namespace canonical
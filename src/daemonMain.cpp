@@ -0,0 +1,260 @@
+#include <unistd.h>
+
+#include <cerrno>
+#include <charconv>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "engineService.hpp"
+#include "puzzleIO.hpp"
+#include "timeline.hpp"
+#include "workerPool.hpp"
+
+// ------------------------
+// sudokuDaemon: long-lived line protocol on stdin/stdout for shell pipelines.
+//   <id> solve <puzzle>             -> <id> ok <solution>     | <id> error unsolvable
+//   <id> generate <difficulty 0-4>  -> <id> ok <puzzle>
+//   <id> count <puzzle> [limit]     -> <id> ok <n>            (limit defaults to 2)
+//   <id> stats <puzzle>             -> <id> ok nodes=<n> ...  (SUDOKUX_ENABLE_STATS builds)
+// <id> is any token without whitespace and is echoed back; replies arrive in completion
+// order, not request order. Bad lines get "<id> error <reason>". Empty lines and lines
+// starting with '#' are ignored. EOF on stdin drains outstanding work and exits.
+// --timeline FILE writes a Chrome trace of the run at exit (SUDOKUX_ENABLE_TIMELINE builds).
+// ------------------------
+
+namespace {
+
+constexpr const char* POOL_FILE = "puzzlePool.bin";
+constexpr size_t CACHE_CAPACITY = 1 << 16;
+constexpr size_t BATCH_LINES = 64;       // commands per worker job
+constexpr size_t READ_CHUNK = 1 << 16;
+
+// Bounds the number of queued jobs so a large input file is not read into memory ahead of
+// the workers
+class JobLimiter {
+   private:
+    std::mutex mutex;
+    std::condition_variable changed;
+    int inFlight = 0;
+    int limit;
+
+   public:
+    explicit JobLimiter(int limit) : limit(limit) {}
+
+    void acquire() {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this]() { return inFlight < limit; });
+        inFlight++;
+    }
+
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            inFlight--;
+        }
+        changed.notify_all();
+    }
+
+    void waitIdle() {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this]() { return inFlight == 0; });
+    }
+};
+
+// splits off the next whitespace-delimited token of [cursor, end)
+bool nextToken(const char*& cursor, const char* end, const char*& token, size_t& length) {
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')) cursor++;
+    if (cursor == end) return false;
+    token = cursor;
+    while (cursor < end && *cursor != ' ' && *cursor != '\t' && *cursor != '\r') cursor++;
+    length = cursor - token;
+    return true;
+}
+
+bool tokenIs(const char* token, size_t length, const char* word) { return length == std::strlen(word) && std::memcmp(token, word, length) == 0; }
+
+// the whole token as a decimal int, false on anything else
+bool parseInt(const char* token, size_t length, int& value) {
+    auto [parsed, error] = std::from_chars(token, token + length, value);
+    return error == std::errc() && parsed == token + length;
+}
+
+void appendCells(std::string& out, const FlatGrid& grid) {
+    char text[CELLS];
+    puzzleIO::formatCells(grid, text);
+    out.append(text, CELLS);
+}
+
+// Runs one command line and appends its reply line to out
+void runCommand(EngineService& engine, const char* line, size_t lineLength, std::string& out) {
+    const char* cursor = line;
+    const char* end = line + lineLength;
+    const char* id;
+    size_t idLength;
+    if (!nextToken(cursor, end, id, idLength) || *id == '#') return;
+
+    out.append(id, idLength);
+    auto fail = [&out](const char* reason) {
+        out += " error ";
+        out += reason;
+        out += '\n';
+    };
+
+    const char* command;
+    size_t commandLength;
+    if (!nextToken(cursor, end, command, commandLength)) return fail("missing-command");
+
+    const char* argument;
+    size_t argumentLength;
+    bool hasArgument = nextToken(cursor, end, argument, argumentLength);
+
+    if (tokenIs(command, commandLength, "generate")) {
+        int difficulty = 0;
+        if (hasArgument && !parseInt(argument, argumentLength, difficulty)) return fail("bad-difficulty");
+        if (difficulty < 0 || difficulty >= SERVICE_DIFFICULTIES) return fail("bad-difficulty");
+        out += " ok ";
+        appendCells(out, engine.generate(difficulty));
+        out += '\n';
+        return;
+    }
+
+    bool solveCommand = tokenIs(command, commandLength, "solve");
+    bool statsCommand = tokenIs(command, commandLength, "stats");
+    if (!solveCommand && !statsCommand && !tokenIs(command, commandLength, "count")) return fail("unknown-command");
+    if (statsCommand && !stats::ENABLED) return fail("stats-disabled");
+
+    FlatGrid puzzle;
+    if (!hasArgument || argumentLength != CELLS || !puzzleIO::parseCells(argument, puzzle)) return fail("bad-puzzle");
+
+    if (statsCommand) {
+        stats::SolverStats counters;
+        if (!engine.profile(puzzle, counters)) return fail("unsolvable");
+        out += " ok ";
+        out += stats::format(counters);
+        out += '\n';
+        return;
+    }
+
+    if (solveCommand) {
+        FlatGrid solution;
+        if (!engine.solve(puzzle, solution)) return fail("unsolvable");
+        out += " ok ";
+        appendCells(out, solution);
+        out += '\n';
+        return;
+    }
+
+    int limit = 2;
+    if (nextToken(cursor, end, argument, argumentLength) && !parseInt(argument, argumentLength, limit)) return fail("bad-limit");
+    if (limit <= 0) return fail("bad-limit");
+    out += " ok ";
+    out += std::to_string(engine.countSolutions(puzzle, limit));
+    out += '\n';
+}
+
+void printUsage(const char* program) {
+    std::cerr << "usage: " << program << " [--threads N] [--pool-workers N] [--timeline FILE]\n"
+              << "  --threads       worker threads, 0 = one per hardware thread (default 0)\n"
+              << "  --pool-workers  background puzzle generators, 0 disables the pool (default 1)\n"
+              << "  --timeline      Chrome trace JSON of the run, written at exit\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int threads = 0;
+    int poolWorkers = 1;
+    std::string timelineFile;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--pool-workers") == 0 && hasValue) {
+            poolWorkers = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--timeline") == 0 && hasValue) {
+            timelineFile = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+    if (!timelineFile.empty()) {
+        if (!timeline::ENABLED) {
+            std::cerr << "--timeline needs a build configured with -DSUDOKUX_ENABLE_TIMELINE=ON\n";
+            return 2;
+        }
+        timeline::nameThread("reader");
+        timeline::start();
+    }
+
+    // stdout carries the protocol; the generators' progress messages go to stderr instead
+    std::cout.rdbuf(std::cerr.rdbuf());
+
+    EngineService engine(CACHE_CAPACITY);
+    if (poolWorkers > 0) {
+        engine.loadPool(POOL_FILE);
+        engine.startPool(poolWorkers);
+    }
+
+    puzzleIO::PuzzleWriter writer(stdout);
+    std::mutex writerMutex;
+
+    WorkerPool workers(threads);
+    JobLimiter limiter(4 * workers.size());
+
+    auto submit = [&](std::string lines) {
+        limiter.acquire();
+        workers.submit([&engine, &writer, &writerMutex, &limiter, lines = std::move(lines)]() {
+            std::string out;
+            out.reserve(lines.size() + lines.size() / 2);
+            for (size_t start = 0; start < lines.size();) {
+                size_t newline = lines.find('\n', start);
+                runCommand(engine, lines.data() + start, newline - start, out);
+                start = newline + 1;
+            }
+
+            if (!out.empty()) {
+                std::lock_guard<std::mutex> lock(writerMutex);
+                writer.write(out.data(), out.size());
+                writer.flush();
+            }
+            limiter.release();
+        });
+    };
+
+    // Every complete line read so far is dispatched right away in jobs of BATCH_LINES, so an
+    // interactive caller gets replies without waiting for a full batch
+    std::string pending;
+    std::vector<char> chunk(READ_CHUNK);
+    while (true) {
+        ssize_t received = read(STDIN_FILENO, chunk.data(), chunk.size());
+        if (received < 0 && errno == EINTR) continue;
+        if (received <= 0) break;
+        pending.append(chunk.data(), received);
+
+        size_t start = 0;
+        while (true) {
+            size_t end = start;
+            size_t lines = 0;
+            for (size_t newline; lines < BATCH_LINES && (newline = pending.find('\n', end)) != std::string::npos; lines++) {
+                end = newline + 1;
+            }
+            if (lines == 0) break;
+            submit(pending.substr(start, end - start));
+            start = end;
+        }
+        pending.erase(0, start);
+    }
+    if (!pending.empty()) submit(pending + '\n');  // last line without a newline
+
+    limiter.waitIdle();
+    if (poolWorkers > 0) engine.savePool(POOL_FILE);
+    if (!timelineFile.empty() && !timeline::stop(timelineFile)) std::cerr << "cannot write " << timelineFile << "\n";
+    return writer.flush() ? 0 : 1;
+}
@@ -1,11 +1,16 @@
 #include <cmath>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
 #define MAX_K 1000
 
 #include "constants.hpp"
+#include "dlxBoard.hpp"
+#include "solveTask.hpp"
+#include "solverStats.hpp"
+#include "timeline.hpp"
 
 namespace DLX {
 
@@ -21,10 +26,10 @@ struct Node {
                    // ID Format: (Candidate, Row, Column)
 };
 
-int SIZE_SQUARED = SIZE * SIZE;
-int SIZE_SQRT = sqrt((double)SIZE);
-int totalRows = SIZE * SIZE * SIZE;
-int totalCols = 4 * SIZE * SIZE;
+constexpr int SIZE_SQUARED = SIZE * SIZE;
+constexpr int SIZE_SQRT = BOX_SIZE;
+constexpr int totalRows = SIZE * SIZE * SIZE;
+constexpr int totalCols = 4 * SIZE * SIZE;
 
 struct Node Head;
 struct Node* HeadNode = &Head;
@@ -45,6 +50,7 @@ void MapSolutionToGrid(std::vector<std::vector<int>>& grid) {
 
 
 void coverColumn(Node* col) {
+    stats::cover();
     col->left->right = col->right;
     col->right->left = col->left;
     for (Node* node = col->down; node != col; node = node->down) {
@@ -57,6 +63,7 @@ void coverColumn(Node* col) {
 }
 
 void uncoverColumn(Node* col) {
+    stats::uncover();
     for (Node* node = col->up; node != col; node = node->up) {
         for (Node* temp = node->left; temp != node; temp = temp->left) {
             temp->head->size++;
@@ -82,8 +89,10 @@ void search(int k, std::vector<std::vector<int>>& originalGrid) {
 
     coverColumn(Col);
 
-    for (Node* temp = Col->down; temp != Col; temp = temp->down) {
+    // stops at the first solution like the compact solver, so both count the same tree
+    for (Node* temp = Col->down; temp != Col && !isSolved; temp = temp->down) {
         solution[k] = temp;
+        stats::enter();
         for (Node* node = temp->right; node != temp; node = node->right) {
             coverColumn(node->head);
         }
@@ -96,6 +105,7 @@ void search(int k, std::vector<std::vector<int>>& originalGrid) {
         for (Node* node = temp->left; node != temp; node = node->left) {
             uncoverColumn(node->head);
         }
+        stats::leave(!isSolved);
     }
 
     uncoverColumn(Col);
@@ -244,14 +254,25 @@ void ConvertDLLtoGrid(std::vector<std::vector<int>>& grid) {
                     coverColumn(node->head);
                 }
             }
+    orig_values[index] = NULL;  // MapSolutionToGrid stops here, not at a previous puzzle's givens
 }
 
 
 bool solver(std::vector<std::vector<int>>& grid) {
-    BuildSparseMatrix(matrix);
-    BuildDLL(matrix);
-    ConvertDLLtoGrid(grid);
-    search(0, grid);
+    isSolved = false;
+    {
+        timeline::Zone zone("build");
+        BuildSparseMatrix(matrix);
+        BuildDLL(matrix);
+    }
+    {
+        timeline::Zone zone("cover");
+        ConvertDLLtoGrid(grid);
+    }
+    {
+        timeline::Zone zone("search");
+        search(0, grid);
+    }
 
     if (isSolved) {
         MapSolutionToGrid(grid);
@@ -260,9 +281,55 @@ bool solver(std::vector<std::vector<int>>& grid) {
     return isSolved;
 }
 
-void solve(std::vector<std::vector<int>>& grid) {
+void solve(std::vector<std::vector<int>>& grid, trace::Recorder* trace) {
+    // the dense matrix above is sized for SIZE, other sizes go to the compact solver
+    if (grid.size() != SIZE || trace) {
+        withBoard(static_cast<int>(grid.size()), [&](auto board) {
+            board = decltype(board)::fromGrid(grid);
+            ExactCover<decltype(board)> matrix(board);
+            matrix.record(trace);
+            if (!matrix.solve(board)) {
+                std::cout << "No solution exists!\n";
+                return;
+            }
+            board.toGrid(grid);
+        });
+        return;
+    }
+
     if (!solver(grid)) {
         std::cout << "No solution exists!\n";
     }
 }
+
+namespace {
+
+template <class B>
+class CoverTask : public SolveTask {
+   private:
+    B board;  // the puzzle, then the solution
+    ExactCover<B> matrix;
+    bool finished = false;
+
+   public:
+    explicit CoverTask(const std::vector<std::vector<int>>& grid) : board(B::fromGrid(grid)), matrix(board) {}
+
+    bool run(long steps) override {
+        if (finished) return true;
+        bool solved;
+        finished = matrix.resume(steps, board, solved);
+        if (finished && !solved) std::cout << "No solution exists!\n";
+        return finished;
+    }
+
+    void result(std::vector<std::vector<int>>& grid) const override { board.toGrid(grid); }
+};
+
+}  // namespace
+
+std::unique_ptr<SolveTask> makeSolveTask(const std::vector<std::vector<int>>& grid) {
+    std::unique_ptr<SolveTask> task;
+    withBoard(static_cast<int>(grid.size()), [&](auto board) { task = std::make_unique<CoverTask<decltype(board)>>(grid); });
+    return task;
+}
 }  // namespace DLX
@@ -0,0 +1,383 @@
+#include "dlxBoard.hpp"
+
+#include "timeline.hpp"
+
+namespace DLX {
+
+// ------------------------
+// Matrix construction
+// ------------------------
+
+// Column layout: cell, row-digit, col-digit and box-digit constraints, each block B::cellCount wide.
+// Constraints already satisfied by a given get no column (index stays 0).
+template <class B>
+ExactCover<B>::ExactCover(const B& puzzle) : puzzle(puzzle) {
+    timeline::Zone zone("build");
+    constexpr int N = B::size;
+    constexpr int CONSTRAINTS = 4 * B::cellCount;
+
+    typename B::Mask rows[N] = {}, cols[N] = {}, boxes[N] = {};
+    for (int cell = 0; cell < B::cellCount; cell++) {
+        int num = puzzle.cells[cell];
+        if (num == EMPTY) continue;
+        typename B::Mask bit = static_cast<typename B::Mask>(1u << num);
+        int row = B::rowOf(cell), col = B::colOf(cell), box = B::boxOfCell(cell);
+        if (num > N || ((rows[row] | cols[col] | boxes[box]) & bit)) contradiction = true;
+        rows[row] |= bit;
+        cols[col] |= bit;
+        boxes[box] |= bit;
+    }
+
+    std::vector<int> columnOf(CONSTRAINTS, 0);
+    int columnCount = 0;
+    for (int cell = 0; cell < B::cellCount; cell++) {
+        if (puzzle.cells[cell] == EMPTY) columnOf[cell] = ++columnCount;
+    }
+    for (int unit = 0; unit < N; unit++) {
+        for (int num = 1; num <= N; num++) {
+            typename B::Mask bit = static_cast<typename B::Mask>(1u << num);
+            int offset = unit * N + num - 1;
+            if (!(rows[unit] & bit)) columnOf[B::cellCount + offset] = ++columnCount;
+            if (!(cols[unit] & bit)) columnOf[2 * B::cellCount + offset] = ++columnCount;
+            if (!(boxes[unit] & bit)) columnOf[3 * B::cellCount + offset] = ++columnCount;
+        }
+    }
+
+    int estimate = 1 + columnCount + 4 * columnCount;
+    for (auto* links : {&left, &right, &up, &down, &column}) links->reserve(estimate);
+    rowOfNode.reserve(estimate);
+    columnSize.assign(columnCount + 1, 0);
+
+    for (int i = 0; i <= columnCount; i++) {
+        left.push_back(i == 0 ? columnCount : i - 1);
+        right.push_back(i == columnCount ? 0 : i + 1);
+        up.push_back(i);
+        down.push_back(i);
+        column.push_back(i);
+        rowOfNode.push_back(-1);
+    }
+
+    candidateNode.assign(B::cellCount * N, -1);
+    if (contradiction) return;
+
+    for (int cell = 0; cell < B::cellCount; cell++) {
+        if (puzzle.cells[cell] != EMPTY) continue;
+        int row = B::rowOf(cell), col = B::colOf(cell), box = B::boxOfCell(cell);
+        typename B::Mask used = rows[row] | cols[col] | boxes[box];
+
+        for (int num = 1; num <= N; num++) {
+            if (used & (1u << num)) continue;
+
+            int matrixRow = static_cast<int>(rowCell.size());
+            rowCell.push_back(cell);
+            rowDigit.push_back(static_cast<uint8_t>(num));
+
+            const int constraints[4] = {columnOf[cell], columnOf[B::cellCount + row * N + num - 1], columnOf[2 * B::cellCount + col * N + num - 1], columnOf[3 * B::cellCount + box * N + num - 1]};
+            int first = -1;
+            for (int col : constraints) {
+                int node = newNode(col);
+                rowOfNode[node] = matrixRow;
+                if (first < 0) {
+                    first = node;
+                    candidateNode[cell * N + num - 1] = node;
+                } else {
+                    left[node] = left[first];
+                    right[node] = first;
+                    right[left[first]] = node;
+                    left[first] = node;
+                }
+            }
+        }
+    }
+}
+
+// appends a node at the bottom of col, linked to itself horizontally
+template <class B>
+int ExactCover<B>::newNode(int col) {
+    int node = static_cast<int>(left.size());
+    left.push_back(node);
+    right.push_back(node);
+    up.push_back(up[col]);
+    down.push_back(col);
+    column.push_back(col);
+    rowOfNode.push_back(-1);
+    down[up[col]] = node;
+    up[col] = node;
+    columnSize[col]++;
+    return node;
+}
+
+// ------------------------
+// Dancing links
+// ------------------------
+
+template <class B>
+void ExactCover<B>::cover(int col) {
+    stats::cover();
+    right[left[col]] = right[col];
+    left[right[col]] = left[col];
+    for (int node = down[col]; node != col; node = down[node]) {
+        for (int temp = right[node]; temp != node; temp = right[temp]) {
+            down[up[temp]] = down[temp];
+            up[down[temp]] = up[temp];
+            columnSize[column[temp]]--;
+        }
+    }
+}
+
+template <class B>
+void ExactCover<B>::uncover(int col) {
+    stats::uncover();
+    for (int node = up[col]; node != col; node = up[node]) {
+        for (int temp = left[node]; temp != node; temp = left[temp]) {
+            columnSize[column[temp]]++;
+            down[up[temp]] = temp;
+            up[down[temp]] = temp;
+        }
+    }
+    right[left[col]] = col;
+    left[right[col]] = col;
+}
+
+// Smallest column first. Ties are broken towards the column whose rows touch the tightest
+// other columns, so the branch taken first prunes the most; 0 / 1 sized columns end the scan.
+template <class B>
+int ExactCover<B>::chooseColumn() const {
+    int best = right[0];
+    int bestSize = columnSize[best];
+    int bestPressure = -1;
+
+    for (int col = best; col != 0; col = right[col]) {
+        int size = columnSize[col];
+        if (size > bestSize) continue;
+        if (size <= 1) return col;
+
+        int pressure = 0;
+        for (int node = down[col]; node != col; node = down[node]) {
+            for (int temp = right[node]; temp != node; temp = right[temp]) pressure += B::size - columnSize[column[temp]];
+        }
+
+        if (size < bestSize || pressure > bestPressure) {
+            best = col;
+            bestSize = size;
+            bestPressure = pressure;
+        }
+    }
+    return best;
+}
+
+// the puzzle plus the assumed rows and the rows chosen above depth
+template <class B>
+void ExactCover<B>::writeSolution(int depth, B& solution) const {
+    solution = puzzle;
+    for (int node : assumed) solution.cells[rowCell[rowOfNode[node]]] = rowDigit[rowOfNode[node]];
+    for (int i = 0; i < depth; i++) {
+        int row = rowOfNode[chosen[i]];
+        solution.cells[rowCell[row]] = rowDigit[row];
+    }
+}
+
+// TRACED is a template flag so the untraced search compiles exactly as before
+template <class B>
+template <bool TRACED>
+void ExactCover<B>::search(int depth, int limit, int& found, B& solution) {
+    if (right[0] == 0) {
+        if (found++ == 0) writeSolution(depth, solution);
+        return;
+    }
+
+    int col = chooseColumn();
+    if (columnSize[col] == 0) return;
+
+    cover(col);
+    for (int node = down[col]; node != col && found < limit; node = down[node]) {
+        chosen[depth] = node;
+        stats::enter();
+        for (int temp = right[node]; temp != node; temp = right[temp]) cover(column[temp]);
+        if constexpr (TRACED) {
+            if (found == 0) recorder->place(rowCell[rowOfNode[node]], rowDigit[rowOfNode[node]]);
+        }
+
+        search<TRACED>(depth + 1, limit, found, solution);
+
+        // nothing is undone on the board once a solution is out
+        if constexpr (TRACED) {
+            if (found == 0) recorder->remove(rowCell[rowOfNode[node]], rowDigit[rowOfNode[node]]);
+        }
+        for (int temp = left[node]; temp != node; temp = left[temp]) uncover(column[temp]);
+        stats::leave(found < limit);
+    }
+    uncover(col);
+}
+
+template <class B>
+bool ExactCover<B>::solve(B& solution) {
+    return count(1, solution) > 0;
+}
+
+// search() with its recursion kept in chosen / chosenColumn, so it can stop after any step
+template <class B>
+bool ExactCover<B>::resume(long steps, B& solution, bool& solved) {
+    solved = false;
+    if (contradiction) return true;
+    if (resumeDepth < 0) {
+        chosen.assign(B::cellCount, 0);
+        chosenColumn.assign(B::cellCount, 0);
+        resumeDepth = 0;
+    }
+
+    for (; steps > 0; steps--) {
+        int node;
+        if (descending) {
+            if (right[0] == 0) {
+                writeSolution(resumeDepth, solution);
+                solved = true;
+                return true;
+            }
+
+            int col = chooseColumn();
+            if (columnSize[col] == 0) {
+                descending = false;
+                continue;
+            }
+            cover(col);
+            chosenColumn[resumeDepth] = col;
+            node = down[col];
+        } else {
+            if (resumeDepth == 0) return true;  // exhausted
+            node = chosen[--resumeDepth];
+            for (int temp = left[node]; temp != node; temp = left[temp]) uncover(column[temp]);
+            stats::leave();
+            node = down[node];
+        }
+
+        int col = chosenColumn[resumeDepth];
+        if (node == col) {
+            uncover(col);
+            descending = false;
+            continue;
+        }
+        chosen[resumeDepth++] = node;
+        stats::enter();
+        for (int temp = right[node]; temp != node; temp = right[temp]) cover(column[temp]);
+        descending = true;
+    }
+    return false;
+}
+
+template <class B>
+int ExactCover<B>::count(int limit) {
+    B scratch;
+    return count(limit, scratch);
+}
+
+template <class B>
+int ExactCover<B>::count(int limit, B& solution) {
+    if (contradiction) return 0;
+    timeline::Zone zone("search");
+    int found = 0;
+    chosen.assign(B::cellCount, 0);
+    if (recorder) {
+        search<true>(0, limit, found, solution);
+    } else {
+        search<false>(0, limit, found, solution);
+    }
+    return found;
+}
+
+// ------------------------
+// Edits between searches
+// ------------------------
+
+// A row is still in the matrix iff every one of its nodes is linked into its column: covering
+// any of its columns, or choosing a conflicting row, unlinks at least one of them
+template <class B>
+bool ExactCover<B>::isLinked(int node) const {
+    int temp = node;
+    do {
+        if (down[up[temp]] != temp) return false;
+        temp = right[temp];
+    } while (temp != node);
+    return true;
+}
+
+// the search's row choice, made outside it
+template <class B>
+bool ExactCover<B>::assume(int cell, int digit) {
+    if (digit < 1 || digit > B::size) return false;
+    int node = candidateNode[cell * B::size + digit - 1];
+    if (node < 0 || !isLinked(node)) return false;
+
+    cover(column[node]);
+    for (int temp = right[node]; temp != node; temp = right[temp]) cover(column[temp]);
+    assumed.push_back(node);
+    return true;
+}
+
+template <class B>
+void ExactCover<B>::release() {
+    int node = assumed.back();
+    assumed.pop_back();
+    for (int temp = left[node]; temp != node; temp = left[temp]) uncover(column[temp]);
+    uncover(column[node]);
+}
+
+template <class B>
+bool ExactCover<B>::exclude(int cell, int digit) {
+    if (digit < 1 || digit > B::size) return false;
+    int node = candidateNode[cell * B::size + digit - 1];
+    if (node < 0 || !isLinked(node)) return false;
+
+    // unlink the whole matrix row from its columns
+    int temp = node;
+    do {
+        up[down[temp]] = up[temp];
+        down[up[temp]] = down[temp];
+        columnSize[column[temp]]--;
+        temp = right[temp];
+    } while (temp != node);
+    excluded.push_back(node);
+    return true;
+}
+
+template <class B>
+void ExactCover<B>::restore() {
+    int node = excluded.back();
+    excluded.pop_back();
+    int temp = node;
+    do {
+        temp = left[temp];
+        columnSize[column[temp]]++;
+        down[up[temp]] = temp;
+        up[down[temp]] = temp;
+    } while (temp != node);
+}
+
+template <class B>
+bool solve(B& board) {
+    ExactCover<B> matrix(board);
+    return matrix.solve(board);
+}
+
+template <class B>
+int countSolutions(const B& board, int limit) {
+    ExactCover<B> matrix(board);
+    return matrix.count(limit);
+}
+
+template <class B>
+bool solveExcluding(const B& board, int cell, int digit, B& solution) {
+    ExactCover<B> matrix(board);
+    matrix.exclude(cell, digit);
+    return matrix.solve(solution);
+}
+
+#define INSTANTIATE_DLX(BOARD)                                           \
+    template class ExactCover<BOARD>;                                    \
+    template bool solve<BOARD>(BOARD&);                                  \
+    template int countSolutions<BOARD>(const BOARD&, int);               \
+    template bool solveExcluding<BOARD>(const BOARD&, int, int, BOARD&);
+SUDOKUX_FOR_EACH_BOARD(INSTANTIATE_DLX)
+#undef INSTANTIATE_DLX
+
+}  // namespace DLX
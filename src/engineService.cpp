@@ -0,0 +1,67 @@
+#include "engineService.hpp"
+
+#include <algorithm>
+
+#include "board.hpp"
+#include "dlxBoard.hpp"
+#include "generatePuzzle.hpp"
+#include "techniqueRater.hpp"
+
+EngineService::EngineService(size_t cacheCapacity) : pool(std::make_unique<PuzzlePool>()), cache(cacheCapacity) {}
+
+bool EngineService::solve(const FlatGrid& puzzle, FlatGrid& solution) {
+    SolutionCache::Key key = SolutionCache::keyOf(puzzle);
+    if (cache.lookup(key, solution)) return true;
+
+    // a fresh ExactCover per call, the legacy DLX keeps global state
+    ClassicBoard board;
+    board.cells = puzzle;
+    if (!DLX::solve(board)) return false;
+
+    solution = board.cells;
+    cache.store(key, puzzle, solution);
+    return true;
+}
+
+int EngineService::countSolutions(const FlatGrid& puzzle, int limit) {
+    ClassicBoard board;
+    board.cells = puzzle;
+    return DLX::countSolutions(board, limit);
+}
+
+bool EngineService::profile(const FlatGrid& puzzle, stats::SolverStats& counters) {
+    ClassicBoard board;
+    board.cells = puzzle;
+    stats::reset();
+    bool solved = DLX::solve(board);
+    counters = stats::snapshot();
+    return solved;
+}
+
+FlatGrid EngineService::generate(int difficulty) {
+    Puzzle puzzle;
+    if (pool->pop(difficulty, puzzle)) return flatten(puzzle.grid);
+
+    puzzle = difficulty < IMPOSSIBLE_DIFFICULTY ? makeRatedPuzzle(difficulty) : makePuzzle(difficulty);
+    return flatten(puzzle.grid);
+}
+
+Rating EngineService::rate(const FlatGrid& puzzle) {
+    Rating rating;
+    rating.givens = static_cast<int>(std::count_if(puzzle.begin(), puzzle.end(), [](uint8_t num) { return num != EMPTY; }));
+    rating.solutions = countSolutions(puzzle, 2);
+    if (rating.solutions != 1) {
+        rating.difficulty = -1;
+        rating.score = 0;
+        rating.label = "Invalid";
+        rating.hardest = "";
+        return rating;
+    }
+
+    rater::Rating graded = rater::rate(puzzle);
+    rating.difficulty = graded.tier;
+    rating.score = graded.score;
+    rating.label = rater::tierName(graded.tier);
+    rating.hardest = graded.solved ? rater::techniqueName(graded.hardest) : "";
+    return rating;
+}
@@ -0,0 +1,39 @@
+#include "flatGrid.hpp"
+
+FlatGrid flatten(const std::vector<std::vector<int>>& grid) {
+    FlatGrid flat;
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
+            flat[row * SIZE + col] = static_cast<uint8_t>(grid[row][col]);
+        }
+    }
+    return flat;
+}
+
+FlatGivens flattenGivens(const std::vector<std::vector<bool>>& givens) {
+    FlatGivens flat;
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
+            flat[row * SIZE + col] = givens[row][col];
+        }
+    }
+    return flat;
+}
+
+void unflatten(const FlatGrid& flat, std::vector<std::vector<int>>& grid) {
+    grid.assign(SIZE, std::vector<int>(SIZE, EMPTY));
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
+            grid[row][col] = flat[row * SIZE + col];
+        }
+    }
+}
+
+void unflattenGivens(const FlatGivens& flat, std::vector<std::vector<bool>>& givens) {
+    givens.assign(SIZE, std::vector<bool>(SIZE, false));
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
+            givens[row][col] = flat[row * SIZE + col];
+        }
+    }
+}
@@ -3,29 +3,61 @@
 #include <algorithm>
 #include <array>
 #include <chrono>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <thread>
 
 #include "generatePuzzle.hpp"
 #include "puzzleRender.hpp"
+#include "timeline.hpp"
 #include "userGame.hpp"
 
-GUI::GUI() : io(ImGui::GetIO()), solverRunning(false), game_started(false), game_solving(false), game_solved(false), selected_difficulty(0), selected_mode(0), selected_algo(ALGO_ALL), timeTaken(0), window_flags(0), hasPrinted(false) {
+constexpr size_t SOLUTION_CACHE_CAPACITY = 256;
+
+// A WebAssembly build without pthreads (pages served without SharedArrayBuffer) has no worker
+// to solve on, so the solve is stepped on the main loop between frames
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+constexpr bool THREADED_SOLVING = false;
+#else
+constexpr bool THREADED_SOLVING = true;
+#endif
+constexpr long SOLVE_SLICE_STEPS = 256;  // well under a millisecond for every engine and size
+constexpr double SOLVE_FRAME_BUDGET_MS = 8.0;
+
+#ifdef __EMSCRIPTEN__
+constexpr float MAIN_FONT_SIZE = 25.0f;
+constexpr float HEADING_FONT_SIZE = 75.0f;
+
+// hardware_concurrency() is navigator.hardwareConcurrency, which also sizes PTHREAD_POOL_SIZE.
+// The solver takes one worker, generation the rest but one left for the browser's main thread.
+static int poolWorkers() {
+    if (!THREADED_SOLVING) return 0;
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()) - 2);
+}
+#else
+constexpr float MAIN_FONT_SIZE = 40.0f;
+constexpr float HEADING_FONT_SIZE = 100.0f;
+constexpr const char* POOL_CACHE_FILE = "puzzlePool.bin";
+
+static int poolWorkers() { return 2; }
+#endif
+
+GUI::GUI() : io(ImGui::GetIO()), solutionCache(SOLUTION_CACHE_CAPACITY), solverRunning(false), game_started(false), game_solving(false), game_solved(false), selected_difficulty(0), selected_mode(0), selected_algo(ALGO_ALL), timeTaken(0), window_flags(0), hasPrinted(false) {
     grid = std::vector<std::vector<int>>(SIZE, std::vector<int>(SIZE, EMPTY));
     givens = std::vector<std::vector<bool>>(SIZE, std::vector<bool>(SIZE, true));
+    gameState = GameState::SizeSelection;
 
     (void)this->io;
     this->io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;  // Enable Keyboard Controls
 
-#ifdef __EMSCRIPTEN__
-    mainFont = this->io.Fonts->AddFontFromFileTTF("assets/font/BebasNeue-Regular.ttf", 25.0f, nullptr, io.Fonts->GetGlyphRangesDefault());
-    headingFont = this->io.Fonts->AddFontFromFileTTF("assets/font/Boldonse-Regular.ttf", 75.0f, nullptr, io.Fonts->GetGlyphRangesDefault());
-#else
-    // Native builds use the relative path
-    mainFont = this->io.Fonts->AddFontFromFileTTF("../assets/font/BebasNeue-Regular.ttf", 40.0f, nullptr, io.Fonts->GetGlyphRangesDefault());
-    headingFont = this->io.Fonts->AddFontFromFileTTF("../assets/font/Boldonse-Regular.ttf", 100.0f, nullptr, io.Fonts->GetGlyphRangesDefault());
+    // until loadFonts() succeeds both stay null, which ImGui draws with its default font
+    mainFont = nullptr;
+    headingFont = nullptr;
+#ifndef SUDOKUX_LAZY_FONTS
+    loadFonts();
 #endif
 
-    this->io.FontDefault = mainFont;
-
     static bool no_titlebar = true;
     static bool no_scrollbar = false;
     static bool no_menu = false;
@@ -38,15 +70,100 @@ GUI::GUI() : io(ImGui::GetIO()), solverRunning(false), game_started(false), game
     if (!no_menu) window_flags |= ImGuiWindowFlags_MenuBar;
     if (no_move) window_flags |= ImGuiWindowFlags_NoMove;
     if (no_resize) window_flags |= ImGuiWindowFlags_NoResize;
+
+    puzzlePool = std::make_unique<PuzzlePool>();
+#ifndef __EMSCRIPTEN__
+    puzzlePool->load(POOL_CACHE_FILE);
+#endif
+    puzzlePool->start(poolWorkers());
+
+    if (THREADED_SOLVING) solverPool = std::make_unique<WorkerPool>(1);
+}
+
+bool GUI::loadFonts() {
+    std::string dir = FONT_DIR;
+    mainFont = io.Fonts->AddFontFromFileTTF((dir + MAIN_FONT_FILE).c_str(), MAIN_FONT_SIZE, nullptr, io.Fonts->GetGlyphRangesDefault());
+    headingFont = io.Fonts->AddFontFromFileTTF((dir + HEADING_FONT_FILE).c_str(), HEADING_FONT_SIZE, nullptr, io.Fonts->GetGlyphRangesDefault());
+    io.FontDefault = mainFont;
+    return mainFont && headingFont;
 }
 
-GUI::~GUI() {}
+GUI::~GUI() {
+    solverPool.reset();  // finishes a running solve before the grid it writes goes away
+#ifndef __EMSCRIPTEN__
+    puzzlePool->save(POOL_CACHE_FILE);
+#endif
+}
 
 void GUI::generatePuzzle() {
-    if (!fillGrid(grid)) {
-        std::cout << "Failed to generate complete grid!\n";
+    timeline::Zone zone("generate");
+    generateTicket++;
+    generatePending = false;
+    steppedGenerate.reset();
+
+    // the pool only holds classic puzzles
+    Puzzle puzzle;
+    if (selected_size == SIZE && puzzlePool->pop(selected_difficulty, puzzle)) {
+        grid = std::move(puzzle.grid);
+        givens = std::move(puzzle.givens);
+        return;
+    }
+
+    // the other sizes dig to a givens band; 16x16 / 25x25 can take seconds
+    int size = selected_size, difficulty = selected_difficulty;
+    auto makeOnDemand = [size, difficulty]() {
+        if (size != SIZE) return makePuzzle(size, difficulty);
+        return difficulty < IMPOSSIBLE_DIFFICULTY ? makeRatedPuzzle(difficulty) : makePuzzle(difficulty);
+    };
+    generatePending = true;
+    if (!solverPool) {
+        // no worker to hand it to: stepGenerate() runs it a few attempts per frame
+        steppedGenerate = makeGenerateTask(size, difficulty);
+        return;
     }
-    digHoles(grid, givens, selected_difficulty);
+
+    // generate on the solver worker and pick the puzzle up on a later frame
+    int ticket = generateTicket;
+    solverPool->submit([this, ticket, makeOnDemand]() {
+        timeline::nameThread("solver");
+        Puzzle result = makeOnDemand();
+        {
+            std::lock_guard<std::mutex> lock(generatedMutex);
+            generated = std::move(result);
+            generatedTicket = ticket;
+        }
+        requestFrame();
+    });
+}
+
+bool GUI::puzzleReady() {
+    if (!generatePending) return true;
+
+    std::lock_guard<std::mutex> lock(generatedMutex);
+    if (generatedTicket != generateTicket) return false;
+    grid = std::move(generated.grid);
+    givens = std::move(generated.givens);
+    generatePending = false;
+    return true;
+}
+
+void GUI::stepGenerate() {
+    timeline::Zone zone("stepGenerate");
+    auto frameStart = std::chrono::steady_clock::now();
+    while (!steppedGenerate->run()) {
+        auto now = std::chrono::steady_clock::now();
+        if (std::chrono::duration<double, std::milli>(now - frameStart).count() >= SOLVE_FRAME_BUDGET_MS) return;
+    }
+
+    std::lock_guard<std::mutex> lock(generatedMutex);
+    generated = steppedGenerate->result();
+    generatedTicket = generateTicket;
+    steppedGenerate.reset();
+}
+
+void GUI::requestFrame() {
+    frameRequested.store(true);
+    if (wakeHandler) wakeHandler();
 }
 
 void GUI::solvePuzzleByAlgo() {
@@ -57,65 +174,111 @@ void GUI::solvePuzzleByAlgo() {
     game_solved = false;
     timeTaken = 0;
 
-    if (solverThread && solverThread->joinable()) {
-        solverThread->join();
+    trace::Recorder* trace = nullptr;
+    traceReplay.stop();
+    if (THREADED_SOLVING && record_trace && selected_algo != ALGO_ALL) {
+        if (!traceRecorder) traceRecorder = std::make_unique<trace::Recorder>();
+        traceRecorder->clear();
+        trace = traceRecorder.get();
+    }
+    replay_pending = trace != nullptr;
+
+    if (!THREADED_SOLVING) {
+        // same engines and order as the threaded path below, without the cache or a trace
+        bool all = selected_algo == ALGO_ALL;
+        steppedSolves.clear();
+        steppedIndex = 0;
+        solvedFromCache = false;
+        if ((all || selected_algo == ALGO_BACKTRACKING) && algoSupportsSize(ALGO_BACKTRACKING, selected_size)) {
+            steppedSolves.push_back({"Backtracking", backtracking::makeSolveTask(grid)});
+        }
+        if ((all || selected_algo == ALGO_SIMULATED_ANNEALING) && algoSupportsSize(ALGO_SIMULATED_ANNEALING, selected_size)) {
+            steppedSolves.push_back({"Simulated Annealing", simulatedAnnealing::makeSolveTask(grid, givens)});
+        }
+        if (all || selected_algo == ALGO_DLX) {
+            steppedSolves.push_back({"Dancing Links", DLX::makeSolveTask(grid)});
+        }
+        stats::reset();
+        return;
     }
 
-    solverThread = std::make_unique<std::thread>([this]() {
+    solverPool->submit([this, trace]() {
+        timeline::nameThread("solver");
+        timeline::Zone zone("solve");
         auto start = std::chrono::high_resolution_clock::now();
 
         if (selected_algo == ALGO_ALL) {
-            std::vector<std::pair<std::string, double>> algo_times;  // <algorithm name, time taken in milliseconds>
+            std::vector<AlgoResult> algo_times;
             std::vector<std::vector<int>> solved_grid;
 
             // Backtracking
-            auto algo_start = std::chrono::high_resolution_clock::now();
-            solved_grid = grid;
-            backtracking::solve(solved_grid);
-            auto algo_end = std::chrono::high_resolution_clock::now();
-            algo_times.emplace_back("Backtracking", std::chrono::duration<double, std::milli>(algo_end - algo_start).count());
+            if (algoSupportsSize(ALGO_BACKTRACKING, selected_size)) {
+                stats::reset();
+                auto algo_start = std::chrono::high_resolution_clock::now();
+                solved_grid = grid;
+                backtracking::solve(solved_grid);
+                auto algo_end = std::chrono::high_resolution_clock::now();
+                algo_times.push_back({"Backtracking", std::chrono::duration<double, std::milli>(algo_end - algo_start).count(), stats::snapshot()});
+            }
 
             // Simulated Annealing
-            algo_start = std::chrono::high_resolution_clock::now();
-            std::vector<std::vector<int>> sa_grid = grid;
-            simulatedAnnealing::solve(sa_grid, givens);
-            algo_end = std::chrono::high_resolution_clock::now();
-            algo_times.emplace_back("Simulated Annealing", std::chrono::duration<double, std::milli>(algo_end - algo_start).count());
+            if (algoSupportsSize(ALGO_SIMULATED_ANNEALING, selected_size)) {
+                stats::reset();
+                auto algo_start = std::chrono::high_resolution_clock::now();
+                std::vector<std::vector<int>> sa_grid = grid;
+                simulatedAnnealing::solve(sa_grid, givens);
+                auto algo_end = std::chrono::high_resolution_clock::now();
+                algo_times.push_back({"Simulated Annealing", std::chrono::duration<double, std::milli>(algo_end - algo_start).count(), stats::snapshot()});
+            }
 
             // Dancing Links
-            algo_start = std::chrono::high_resolution_clock::now();
+            stats::reset();
+            auto algo_start = std::chrono::high_resolution_clock::now();
             solved_grid = grid;
             DLX::solve(solved_grid);
-            algo_end = std::chrono::high_resolution_clock::now();
-            algo_times.emplace_back("Dancing Links", std::chrono::duration<double, std::milli>(algo_end - algo_start).count());
+            auto algo_end = std::chrono::high_resolution_clock::now();
+            algo_times.push_back({"Dancing Links", std::chrono::duration<double, std::milli>(algo_end - algo_start).count(), stats::snapshot()});
 
-            sort(algo_times.begin(), algo_times.end(), [](const auto& a, const auto& b) { return a.second < b.second; });
+            sort(algo_times.begin(), algo_times.end(), [](const auto& a, const auto& b) { return a.milliseconds < b.milliseconds; });
 
             timeResults = algo_times;
             grid = solved_grid;
         } else {
+            stats::reset();
             auto algo_start = std::chrono::high_resolution_clock::now();
 
+            auto runSelectedAlgo = [this, trace](std::vector<std::vector<int>>& puzzle) {
+                switch (selected_algo) {
+                    case ALGO_BACKTRACKING:
+                        backtracking::solve(puzzle, trace);
+                        break;
+                    case ALGO_SIMULATED_ANNEALING:
+                        simulatedAnnealing::solve(puzzle, givens, trace);
+                        break;
+                    case ALGO_DLX:
+                        std::cout << "DLX solving started\n";
+                        DLX::solve(puzzle, trace);
+                        std::cout << "DLX solving finished\n";
+
+                        break;
+                    default:
+                        break;
+                }
+            };
+
             // std::vector<std::vector<int>> temp_grid = grid;
-            switch (selected_algo) {
-                case ALGO_BACKTRACKING:
-                    backtracking::solve(grid);
-                    break;
-                case ALGO_SIMULATED_ANNEALING:
-                    simulatedAnnealing::solve(grid, givens);
-                    break;
-                case ALGO_DLX:
-                    std::cout << "DLX solving started\n";
-                    DLX::solve(grid);
-                    std::cout << "DLX solving finished\n";
-
-                    break;
-                default:
-                    break;
+            // the cache is keyed on classic-size canonical forms
+            // a cache hit has no search to replay
+            if (use_solution_cache && selected_size == SIZE && !trace) {
+                solvedFromCache = solutionCache.solve(grid, runSelectedAlgo);
+            } else {
+                solvedFromCache = false;
+                runSelectedAlgo(grid);
             }
 
             auto algo_end = std::chrono::high_resolution_clock::now();
             timeTaken = std::chrono::duration<double, std::milli>(algo_end - algo_start).count();
+            solveStats = stats::snapshot();
 
             // grid = temp_grid;  // Update grid with solution
         }
@@ -123,11 +286,60 @@ void GUI::solvePuzzleByAlgo() {
         game_solved = true;
         game_solving = false;
         solverRunning.store(false);
+        requestFrame();
 
         // std::this_thread::sleep_for(std::chrono::milliseconds(10));
     });
 }
 
+void GUI::stepSolve() {
+    timeline::Zone zone("stepSolve");
+    auto frameStart = std::chrono::steady_clock::now();
+    while (steppedIndex < steppedSolves.size()) {
+        SteppedSolve& solve = steppedSolves[steppedIndex];
+        auto sliceStart = std::chrono::steady_clock::now();
+        bool finished = solve.task->run(SOLVE_SLICE_STEPS);
+        auto sliceEnd = std::chrono::steady_clock::now();
+        solve.milliseconds += std::chrono::duration<double, std::milli>(sliceEnd - sliceStart).count();
+
+        if (finished) {
+            if (steppedIndex + 1 == steppedSolves.size()) solve.task->result(grid);
+            solve.stats = stats::snapshot();
+            stats::reset();
+            steppedIndex++;
+        }
+        if (std::chrono::duration<double, std::milli>(sliceEnd - frameStart).count() >= SOLVE_FRAME_BUDGET_MS) return;
+    }
+
+    if (selected_algo == ALGO_ALL) {
+        std::vector<AlgoResult> algo_times;
+        for (const SteppedSolve& solve : steppedSolves) algo_times.push_back({solve.name, solve.milliseconds, solve.stats});
+        sort(algo_times.begin(), algo_times.end(), [](const auto& a, const auto& b) { return a.milliseconds < b.milliseconds; });
+        timeResults = algo_times;
+    } else if (!steppedSolves.empty()) {
+        timeTaken = steppedSolves.back().milliseconds;
+        solveStats = steppedSolves.back().stats;
+    }
+    steppedSolves.clear();
+
+    game_solved = true;
+    game_solving = false;
+    solverRunning.store(false);
+}
+
+double GUI::idleTimeout() const {
+    if (!steppedSolves.empty() || generatePending) return 0.0;
+    if (gameState == GameState::AlgoSolving && (solverRunning.load() || traceReplay.animating())) return 0.0;
+
+    if (gameState == GameState::UserPlayingMode && timerRunning) {
+        // the clock shows whole seconds
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        return std::ceil(elapsed + 1e-3) - elapsed;
+    }
+
+    return std::numeric_limits<double>::infinity();
+}
+
 void GUI::renderTime() {
     ImGui::Spacing();
     ImGui::Spacing();
@@ -138,17 +350,21 @@ void GUI::renderTime() {
         ImGui::Spacing();
 
         for (const auto& result : timeResults) {
-            if (result.second >= 1000) {
-                ImGui::Text("%s: %.2f seconds", result.first.c_str(), result.second / 1000.0);
-            } else if (result.second >= 1.0) {
-                ImGui::Text("%s: %.2f milliseconds", result.first.c_str(), result.second);
-            } else if (result.second >= 0.001) {
-                ImGui::Text("%s: %.2f microseconds", result.first.c_str(), result.second * 1000.0);
+            if (result.milliseconds >= 1000) {
+                ImGui::Text("%s: %.2f seconds", result.name.c_str(), result.milliseconds / 1000.0);
+            } else if (result.milliseconds >= 1.0) {
+                ImGui::Text("%s: %.2f milliseconds", result.name.c_str(), result.milliseconds);
+            } else if (result.milliseconds >= 0.001) {
+                ImGui::Text("%s: %.2f microseconds", result.name.c_str(), result.milliseconds * 1000.0);
             } else {
-                ImGui::Text("%s: %.2f nanoseconds", result.first.c_str(), result.second * 1000000.0);
+                ImGui::Text("%s: %.2f nanoseconds", result.name.c_str(), result.milliseconds * 1000000.0);
             }
+            if (stats::ENABLED) ImGui::Text("    %s", stats::format(result.stats).c_str());
         }
     } else {
+        if (solvedFromCache) {
+            ImGui::TextUnformatted("Solution served from cache");
+        }
         if (timeTaken >= 1000) {
             ImGui::Text("Time taken: %.2f seconds", timeTaken / 1000.0);
         } else if (timeTaken >= 1.0) {
@@ -158,6 +374,7 @@ void GUI::renderTime() {
         } else {
             ImGui::Text("Time taken: %.3f nanoseconds", timeTaken * 1000000.0);
         }
+        if (stats::ENABLED && !solvedFromCache) ImGui::Text("%s", stats::format(solveStats).c_str());
     }
 }
 
@@ -216,20 +433,35 @@ void CenterComponent(F&& componentFunc) {
     componentFunc();
 }
 
-void GUI::stateDifficultySelection() {
-    grid.assign(SIZE, std::vector<int>(SIZE, EMPTY));
-    givens.assign(SIZE, std::vector<bool>(SIZE, true));
+void GUI::stateSizeSelection() {
+    static constexpr const char* sizeLabels[] = {"4x4", "6x6", "9x9", "12x12", "16x16", "25x25"};
+    static_assert(std::size(sizeLabels) == std::size(BOARD_SIZES), "one label per board size");
 
+    ImGui::TextUnformatted("Select Board Size:");
+
+    for (size_t i = 0; i < std::size(BOARD_SIZES); i++) {
+        ImGui::RadioButton(sizeLabels[i], &selected_size, BOARD_SIZES[i]);
+    }
+
+    if (ImGui::Button("Next ->")) gameState = GameState::DifficultySelection;
+}
+void GUI::stateDifficultySelection() {
     ImGui::TextUnformatted("Select Difficulty:");
 
     static constexpr int totalDifficulty = 5;
-    static const std::array<std::string, totalDifficulty> difficultyLevels = {"Easy", "Medium", "Hard", "Evil", "Impossible"};
+    static constexpr const char* difficultyLevels[totalDifficulty] = {"Easy", "Medium", "Hard", "Evil", "Impossible"};
 
     for (int i = 0; i < totalDifficulty; ++i) {
-        ImGui::RadioButton(difficultyLevels[i].c_str(), &selected_difficulty, i);
+        ImGui::RadioButton(difficultyLevels[i], &selected_difficulty, i);
     }
 
-    if (ImGui::Button("Next ->")) gameState = GameState::WhoPlaysSelection;
+    if (ImGui::Button("Next ->")) {
+        // sized once here rather than every frame, generatePuzzle fills it in
+        grid.assign(selected_size, std::vector<int>(selected_size, EMPTY));
+        givens.assign(selected_size, std::vector<bool>(selected_size, true));
+        gameState = GameState::WhoPlaysSelection;
+    }
+    if (ImGui::Button("Back")) gameState = GameState::SizeSelection;
 }
 void GUI::stateWhoPlaysSelection() {
     ImGui::TextUnformatted("Select Mode:");
@@ -251,9 +483,20 @@ void GUI::stateAlgoSelection() {
     ImGui::TextUnformatted("Select Solving Algorithm:");
 
     static constexpr int totalAlgos = 4;
-    static const std::array<std::string, totalAlgos> solvingAlgos = {"All algos for benchmarking", "Backtracking", "Simulated Annealing", "Dancing Links"};
+    static constexpr const char* solvingAlgos[totalAlgos] = {"All algos for benchmarking", "Backtracking", "Simulated Annealing", "Dancing Links"};
+    if (!algoSupportsSize(selected_algo, selected_size)) selected_algo = ALGO_DLX;
     for (int i = 0; i < totalAlgos; ++i) {
-        ImGui::RadioButton(solvingAlgos[i].c_str(), &selected_algo, i);
+        ImGui::BeginDisabled(!algoSupportsSize(i, selected_size));
+        ImGui::RadioButton(solvingAlgos[i], &selected_algo, i);
+        ImGui::EndDisabled();
+    }
+
+    // benchmarking always runs the engines, the cache only fronts single-algorithm solves
+    if (selected_algo != ALGO_ALL && selected_size == SIZE && THREADED_SOLVING) {
+        ImGui::Checkbox("Use solution cache", &use_solution_cache);
+    }
+    if (selected_algo != ALGO_ALL && THREADED_SOLVING) {
+        ImGui::Checkbox("Record steps for replay", &record_trace);
     }
 
     if (ImGui::Button("Next ->")) {
@@ -265,7 +508,11 @@ void GUI::stateAlgoSelection() {
 }
 void GUI::statePlayingMode() {
     if (game_started) {
-        generatePuzzle();
+        if (!generatePending) generatePuzzle();
+        if (!puzzleReady()) {
+            renderGenerating();
+            return;
+        }
         game_started = false;
     }
 
@@ -276,7 +523,7 @@ void GUI::statePlayingMode() {
         solvePuzzleByAlgo();
     }
 
-    if (ImGui::Button("Return to Menu")) gameState = GameState::DifficultySelection;
+    if (ImGui::Button("Return to Menu")) gameState = GameState::SizeSelection;
     ImGui::SameLine();
 }
 void GUI::stateAlgoSolving() {
@@ -285,21 +532,52 @@ void GUI::stateAlgoSolving() {
         Spinner("##spinner", 20.0f, 4, ImGui::GetColorU32(ImVec4(1, 1, 1, 1)));  // White spinner
 
     } else if (game_solved) {
-        renderPuzzleForAlgo(grid, givens);
+        if (replay_pending && !solverRunning.load()) {
+            traceReplay.start(*traceRecorder, grid, givens);
+            replay_pending = false;
+        }
+
+        if (traceReplay.active()) {
+            traceReplay.render();
+        } else {
+            renderPuzzleForAlgo(grid, givens);
+        }
         renderTime();
     }
 
-    if (ImGui::Button("Return to Menu")) gameState = GameState::DifficultySelection;
+    if (ImGui::Button("Return to Menu")) gameState = GameState::SizeSelection;
+}
+
+// spinner until puzzleReady(), leaving abandons the request
+void GUI::renderGenerating() {
+    ImGui::TextUnformatted("Generating puzzle...");
+    Spinner("##generating", 20.0f, 4, ImGui::GetColorU32(ImVec4(1, 1, 1, 1)));
+
+    if (ImGui::Button("Return to Menu")) {
+        generatePending = false;
+        steppedGenerate.reset();
+        game_started = false;
+        gameState = GameState::SizeSelection;
+    }
 }
 
 void GUI::stateUserPlayingMode() {
     if (game_started) {
-        generatePuzzle();
+        if (!generatePending) generatePuzzle();
+        if (!puzzleReady()) {
+            renderGenerating();
+            return;
+        }
+        player.reset(grid);
         game_started = false;
         startTime = std::chrono::steady_clock::now();
         timerRunning = true;
     }
 
+    if (timerRunning && player.solved()) {
+        timerRunning = false;  // freezes runningTime at the solve time
+    }
+
     if (timerRunning) {
         auto now = std::chrono::steady_clock::now();
         runningTime = std::chrono::duration<double>(now - startTime).count();
@@ -311,40 +589,48 @@ void GUI::stateUserPlayingMode() {
 
     ImGui::Text("Time Elapsed: %02d:%02d:%02d", hours, minutes, seconds);
 
-    bool puzzleSolved = false;
-    float elapsedTime = 0.0f;
+    renderPuzzleForUser(grid, givens, player);
 
-    renderPuzzleForUser(grid, givens, puzzleSolved, elapsedTime);
+    if (player.solved()) {
+        ImGui::Spacing();
+        ImGui::Text("Puzzle Solved Successfully in %.2f seconds!", runningTime);
+    }
 
     ImGui::Spacing();
     ImGui::Spacing();
     ImGui::Spacing();
     ImGui::Spacing();
 
-    renderInputGrid(grid, givens);
+    renderInputGrid(grid, givens, player);
     ImGui::Spacing();
 
-    renderClearButton(grid);
+    renderClearButton(grid, givens, player);
     ImGui::SameLine();
 
     if (ImGui::Button("Restart", ImVec2(100, 50))) {
-        for (int i = 0; i < SIZE; i++) {
-            for (int j = 0; j < SIZE; j++) {
+        for (int i = 0; i < selected_size; i++) {
+            for (int j = 0; j < selected_size; j++) {
                 if (!givens[i][j]) {
                     grid[i][j] = 0;
                 }
             }
         }
+        player.reset(grid);
         startTime = std::chrono::steady_clock::now();
         runningTime = 0;
+        timerRunning = true;
     }
     ImGui::SameLine();
 
-    if (ImGui::Button("Return to Menu")) gameState = GameState::DifficultySelection;
+    if (ImGui::Button("Return to Menu")) gameState = GameState::SizeSelection;
 
     ImGui::Spacing();
 }
 void GUI::renderUI() {
+    // a stepped solve keeps going on every screen, like the threaded one
+    if (!THREADED_SOLVING && game_solving) stepSolve();
+    if (steppedGenerate) stepGenerate();
+
     if (windowSize.x != io.DisplaySize.x * 0.8f || windowSize.y != io.DisplaySize.y * 0.98f) {
         windowSize = ImVec2(io.DisplaySize.x * 0.8f, io.DisplaySize.y * 0.98f);
         center = ImVec2(io.DisplaySize.x * 0.5f, io.DisplaySize.y * 0.5f);
@@ -366,6 +652,10 @@ void GUI::renderUI() {
     ImGui::Spacing();
 
     switch (gameState) {
+        case GameState::SizeSelection:
+            stateSizeSelection();
+            break;
+
         case GameState::DifficultySelection:
             stateDifficultySelection();
             break;
@@ -390,7 +680,7 @@ void GUI::renderUI() {
             stateUserPlayingMode();
             break;
         default:
-            gameState = GameState::DifficultySelection;
+            gameState = GameState::SizeSelection;
             break;
     }
 
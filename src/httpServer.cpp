@@ -0,0 +1,433 @@
+#include "httpServer.hpp"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+constexpr size_t MAX_HEADER_BYTES = 16 * 1024;
+constexpr size_t MAX_BODY_BYTES = 4 * 1024 * 1024;
+constexpr size_t MAX_PENDING = 256;  // per connection, reading pauses beyond this
+constexpr size_t BATCH_LIMIT = 32;   // requests per worker job
+constexpr int POLL_TIMEOUT_MS = 1000;
+constexpr auto IDLE_TIMEOUT = std::chrono::seconds(60);
+
+struct ParsedRequest {
+    HttpRequest request;
+    bool keepAlive;
+};
+
+const char* statusText(int status) {
+    switch (status) {
+        case 200:
+            return "OK";
+        case 204:
+            return "No Content";
+        case 400:
+            return "Bad Request";
+        case 404:
+            return "Not Found";
+        case 405:
+            return "Method Not Allowed";
+        case 413:
+            return "Payload Too Large";
+        case 422:
+            return "Unprocessable Entity";
+        default:
+            return "Internal Server Error";
+    }
+}
+
+std::string serialize(const HttpResponse& response, bool keepAlive) {
+    std::string out;
+    out.reserve(160 + response.body.size());
+    out += "HTTP/1.1 ";
+    out += std::to_string(response.status);
+    out += ' ';
+    out += statusText(response.status);
+    out += "\r\nContent-Type: ";
+    out += response.contentType;
+    out += "\r\nContent-Length: ";
+    out += std::to_string(response.body.size());
+    // the web frontend is served from another origin
+    out += "\r\nAccess-Control-Allow-Origin: *\r\nAccess-Control-Allow-Headers: Content-Type";
+    out += keepAlive ? "\r\nConnection: keep-alive\r\n\r\n" : "\r\nConnection: close\r\n\r\n";
+    out += response.body;
+    return out;
+}
+
+std::string lowercase(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+// 1 = parsed one request, 0 = need more bytes, -1 = malformed, -2 = too large
+int parseOne(const std::string& input, size_t start, size_t& consumed, ParsedRequest& parsed) {
+    size_t headerEnd = input.find("\r\n\r\n", start);
+    if (headerEnd == std::string::npos) return input.size() - start > MAX_HEADER_BYTES ? -2 : 0;
+
+    size_t lineEnd = input.find("\r\n", start);
+    std::string requestLine = input.substr(start, lineEnd - start);
+    size_t firstSpace = requestLine.find(' ');
+    size_t secondSpace = requestLine.find(' ', firstSpace + 1);
+    if (firstSpace == std::string::npos || secondSpace == std::string::npos) return -1;
+
+    HttpRequest& request = parsed.request;
+    request.method = requestLine.substr(0, firstSpace);
+    std::string target = requestLine.substr(firstSpace + 1, secondSpace - firstSpace - 1);
+    std::string version = requestLine.substr(secondSpace + 1);
+    if (version.compare(0, 5, "HTTP/") != 0) return -1;
+
+    size_t question = target.find('?');
+    request.path = target.substr(0, question);
+    request.query = question == std::string::npos ? "" : target.substr(question + 1);
+
+    parsed.keepAlive = version != "HTTP/1.0";
+    size_t contentLength = 0;
+    for (size_t pos = lineEnd + 2; pos < headerEnd;) {
+        size_t end = input.find("\r\n", pos);
+        std::string line = input.substr(pos, end - pos);
+        pos = end + 2;
+
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) return -1;
+        std::string name = lowercase(line.substr(0, colon));
+        size_t valueStart = line.find_first_not_of(" \t", colon + 1);
+        std::string value = valueStart == std::string::npos ? "" : line.substr(valueStart);
+
+        if (name == "content-length") {
+            char* rest = nullptr;
+            unsigned long long length = std::strtoull(value.c_str(), &rest, 10);
+            if (rest == value.c_str()) return -1;
+            if (length > MAX_BODY_BYTES) return -2;
+            contentLength = static_cast<size_t>(length);
+        } else if (name == "connection") {
+            std::string token = lowercase(value);
+            if (token.find("close") != std::string::npos) parsed.keepAlive = false;
+            if (token.find("keep-alive") != std::string::npos) parsed.keepAlive = true;
+        } else if (name == "transfer-encoding") {
+            return -1;  // chunked bodies are not supported, clients send Content-Length
+        }
+    }
+
+    size_t bodyStart = headerEnd + 4;
+    if (input.size() < bodyStart + contentLength) return 0;
+
+    request.body = input.substr(bodyStart, contentLength);
+    consumed = bodyStart + contentLength - start;
+    return 1;
+}
+
+}  // namespace
+
+std::string queryParameter(const std::string& query, const std::string& key) {
+    size_t pos = 0;
+    while (pos <= query.size()) {
+        size_t end = query.find('&', pos);
+        if (end == std::string::npos) end = query.size();
+
+        size_t equals = query.find('=', pos);
+        if (equals != std::string::npos && equals < end && query.compare(pos, equals - pos, key) == 0 && equals - pos == key.size()) {
+            return query.substr(equals + 1, end - equals - 1);
+        }
+        pos = end + 1;
+    }
+    return "";
+}
+
+void appendJsonString(std::string& out, const std::string& text) {
+    out += '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+// ------------------------
+// Lifecycle
+// ------------------------
+
+HttpServer::HttpServer(WorkerPool& workers, HttpHandler handler) : workers(workers), handler(std::move(handler)) {
+    if (pipe(wakePipe) == 0) {
+        fcntl(wakePipe[0], F_SETFL, O_NONBLOCK);
+        fcntl(wakePipe[1], F_SETFL, O_NONBLOCK);
+    }
+}
+
+HttpServer::~HttpServer() {
+    for (auto& connection : connections) close(connection->fd);
+    if (listenFd >= 0) close(listenFd);
+    close(wakePipe[0]);
+    close(wakePipe[1]);
+}
+
+bool HttpServer::listen(uint16_t port) {
+    listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        std::cerr << "socket: " << std::strerror(errno) << "\n";
+        return false;
+    }
+
+    int enable = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listenFd, SOMAXCONN) != 0) {
+        std::cerr << "bind 127.0.0.1:" << port << ": " << std::strerror(errno) << "\n";
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    fcntl(listenFd, F_SETFL, O_NONBLOCK);
+    return true;
+}
+
+void HttpServer::stop() {
+    stopping.store(true);
+    wake();
+}
+
+void HttpServer::wake() {
+    char byte = 1;
+    ssize_t written = write(wakePipe[1], &byte, 1);  // a full pipe already guarantees a wake-up
+    (void)written;
+}
+
+// ------------------------
+// I/O loop
+// ------------------------
+
+void HttpServer::run() {
+    std::vector<pollfd> fds;
+
+    while (!stopping.load()) {
+        fds.clear();
+        fds.push_back({listenFd, POLLIN, 0});
+        fds.push_back({wakePipe[0], POLLIN, 0});
+        for (auto& connection : connections) {
+            short events = 0;
+            if (connection->pending.size() < MAX_PENDING && !connection->closeAfterPending && !connection->peerClosed) {
+                events |= POLLIN;
+            }
+            if (connection->outputSent < connection->output.size()) events |= POLLOUT;
+            fds.push_back({connection->fd, events, 0});
+        }
+
+        if (poll(fds.data(), fds.size(), POLL_TIMEOUT_MS) < 0 && errno != EINTR) {
+            std::cerr << "poll: " << std::strerror(errno) << "\n";
+            break;
+        }
+
+        if (fds[1].revents & POLLIN) {
+            char drain[256];
+            while (read(wakePipe[0], drain, sizeof(drain)) > 0) {
+            }
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        std::vector<bool> keep(connections.size(), true);
+        for (size_t i = 0; i < connections.size(); i++) {
+            Connection& connection = *connections[i];
+            short revents = fds[i + 2].revents;
+
+            if (revents & (POLLERR | POLLNVAL)) {
+                keep[i] = false;
+                continue;
+            }
+            if (revents & (POLLIN | POLLHUP)) {
+                if (!readInput(connection)) {
+                    keep[i] = false;
+                    continue;
+                }
+                connection.lastActivity = now;
+            }
+            // also resumes parsing input held back while the connection was at MAX_PENDING
+            if (!connection.closeAfterPending && (!connection.input.empty() || connection.peerClosed)) {
+                parseRequests(connection);
+            }
+
+            collectResponses(connection);
+            if (!writeOutput(connection)) {
+                keep[i] = false;
+                continue;
+            }
+
+            bool drained = connection.pending.empty() && connection.outputSent == connection.output.size();
+            if (drained && connection.closeAfterPending) keep[i] = false;
+            if (drained && now - connection.lastActivity > IDLE_TIMEOUT) keep[i] = false;
+        }
+
+        // connections accepted below are not in fds yet, so compact before accepting
+        size_t next = 0;
+        for (size_t i = 0; i < connections.size(); i++) {
+            if (keep[i]) {
+                connections[next++] = std::move(connections[i]);
+            } else {
+                close(connections[i]->fd);
+            }
+        }
+        connections.resize(next);
+
+        if (fds[0].revents & POLLIN) acceptConnections();
+    }
+
+    while (jobsInFlight.load() > 0) {
+        pollfd wakeFd{wakePipe[0], POLLIN, 0};
+        poll(&wakeFd, 1, 10);
+        char drain[256];
+        while (read(wakePipe[0], drain, sizeof(drain)) > 0) {
+        }
+    }
+}
+
+void HttpServer::acceptConnections() {
+    while (true) {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) return;  // EAGAIN: backlog drained
+
+        fcntl(fd, F_SETFL, O_NONBLOCK);
+        int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+        auto connection = std::make_unique<Connection>();
+        connection->fd = fd;
+        connection->lastActivity = std::chrono::steady_clock::now();
+        connections.push_back(std::move(connection));
+    }
+}
+
+bool HttpServer::readInput(Connection& connection) {
+    char buffer[64 * 1024];
+    while (true) {
+        ssize_t received = recv(connection.fd, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            connection.input.append(buffer, received);
+            if (received < static_cast<ssize_t>(sizeof(buffer))) return true;
+        } else if (received == 0) {
+            connection.peerClosed = true;
+            return true;
+        } else {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+    }
+}
+
+void HttpServer::parseRequests(Connection& connection) {
+    std::vector<ParsedRequest> batch;
+    std::vector<std::shared_ptr<Slot>> slots;
+
+    auto submitBatch = [&]() {
+        if (batch.empty()) return;
+        jobsInFlight++;
+        workers.submit([this, batch = std::move(batch), slots = std::move(slots)]() {
+            for (size_t i = 0; i < batch.size(); i++) {
+                HttpResponse response;
+                try {
+                    response = handler(batch[i].request);
+                } catch (const std::exception& error) {
+                    response = {500, "application/json", "{\"error\":"};
+                    appendJsonString(response.body, error.what());
+                    response.body += '}';
+                }
+                std::string bytes = serialize(response, batch[i].keepAlive);
+
+                std::lock_guard<std::mutex> lock(completionMutex);
+                slots[i]->bytes = std::move(bytes);
+                slots[i]->ready = true;
+            }
+            wake();
+            jobsInFlight--;
+        });
+        batch.clear();
+        slots.clear();
+    };
+
+    size_t offset = 0;
+    while (!connection.closeAfterPending && connection.pending.size() < MAX_PENDING) {
+        ParsedRequest parsed;
+        size_t consumed = 0;
+        int result = parseOne(connection.input, offset, consumed, parsed);
+        if (result == 0) break;
+
+        auto slot = std::make_shared<Slot>();
+        connection.pending.push_back(slot);
+
+        if (result < 0) {
+            // answered inline, the stream cannot be resynchronized after a bad request
+            HttpResponse error{result == -2 ? 413 : 400, "application/json", "{\"error\":\"malformed request\"}"};
+            slot->bytes = serialize(error, false);
+            std::lock_guard<std::mutex> lock(completionMutex);
+            slot->ready = true;
+            connection.closeAfterPending = true;
+            offset = connection.input.size();
+            break;
+        }
+
+        offset += consumed;
+        bool last = !parsed.keepAlive;
+
+        if (parsed.request.method == "OPTIONS") {
+            // CORS preflight, no need to bother a worker
+            slot->bytes = serialize({204, "text/plain", ""}, parsed.keepAlive);
+            std::lock_guard<std::mutex> lock(completionMutex);
+            slot->ready = true;
+        } else {
+            batch.push_back(std::move(parsed));
+            slots.push_back(slot);
+            if (batch.size() == BATCH_LIMIT) submitBatch();
+        }
+
+        if (last) {
+            connection.closeAfterPending = true;
+            offset = connection.input.size();
+        }
+    }
+    submitBatch();
+
+    connection.input.erase(0, offset);
+    // peer finished sending: answer what was already requested, then close
+    if (connection.peerClosed) connection.closeAfterPending = true;
+}
+
+void HttpServer::collectResponses(Connection& connection) {
+    std::lock_guard<std::mutex> lock(completionMutex);
+    while (!connection.pending.empty() && connection.pending.front()->ready) {
+        connection.output += connection.pending.front()->bytes;
+        connection.pending.pop_front();
+    }
+}
+
+bool HttpServer::writeOutput(Connection& connection) {
+    while (connection.outputSent < connection.output.size()) {
+        ssize_t sent = send(connection.fd, connection.output.data() + connection.outputSent, connection.output.size() - connection.outputSent, MSG_NOSIGNAL);
+        if (sent < 0) return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        connection.outputSent += sent;
+    }
+    connection.output.clear();
+    connection.outputSent = 0;
+    return true;
+}
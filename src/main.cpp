@@ -1,9 +1,14 @@
 #include <stdio.h>
 
+#include <cstdlib>
+#include <limits>
+#include <string>
+
 #include "gameUI.hpp"
 #include "imgui.h"
 #include "imgui_impl_glfw.h"
 #include "imgui_impl_opengl3.h"
+#include "timeline.hpp"
 
 #define GL_SILENCE_DEPRECATION
 #if defined(IMGUI_IMPL_OPENGL_ES2)
@@ -18,6 +23,7 @@
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
 #include <emscripten/html5.h>
+#include <sys/stat.h>
 #endif
 
 #ifndef __EMSCRIPTEN__
@@ -50,23 +56,52 @@ void setWindowIcon(GLFWwindow* window) {
 }
 #endif
 
-// Main loop function for emscripten
-#ifdef __EMSCRIPTEN__
-void main_loop_iteration() {
-    if (!g_window || !g_gui)
-        return;
+// ------------------------
+// Frame pacing: a frame is drawn only after input, while the GUI animates, or when its
+// clock ticks. Input callbacks are installed before the ImGui backend, which chains them,
+// and each one schedules a few frames so ImGui can settle hover and layout state.
+// ------------------------
+
+constexpr int FRAMES_AFTER_INPUT = 3;
+int g_pending_frames = FRAMES_AFTER_INPUT;  // the first frames draw the initial screen
+
+void requestFrames() { g_pending_frames = FRAMES_AFTER_INPUT; }
+
+void installWakeCallbacks(GLFWwindow* window) {
+    glfwSetWindowFocusCallback(window, [](GLFWwindow*, int) { requestFrames(); });
+    glfwSetCursorEnterCallback(window, [](GLFWwindow*, int) { requestFrames(); });
+    glfwSetCursorPosCallback(window, [](GLFWwindow*, double, double) { requestFrames(); });
+    glfwSetMouseButtonCallback(window, [](GLFWwindow*, int, int, int) { requestFrames(); });
+    glfwSetScrollCallback(window, [](GLFWwindow*, double, double) { requestFrames(); });
+    glfwSetKeyCallback(window, [](GLFWwindow*, int, int, int, int) { requestFrames(); });
+    glfwSetCharCallback(window, [](GLFWwindow*, unsigned int) { requestFrames(); });
+    glfwSetWindowSizeCallback(window, [](GLFWwindow*, int, int) { requestFrames(); });
+    glfwSetWindowRefreshCallback(window, [](GLFWwindow*) { requestFrames(); });
+}
 
-    glfwPollEvents();
-    if (glfwGetWindowAttrib(g_window, GLFW_ICONIFIED) != 0) {
-        return;
-    }
+double g_next_tick = 0.0;  // glfwGetTime() at which the GUI changes on its own
+
+// Whether this iteration should draw
+bool frameDue() {
+    bool solverDone = g_gui->takeFrameRequest();
+    if (solverDone || glfwGetTime() >= g_next_tick) requestFrames();
+    if (g_pending_frames == 0) return false;
+    g_pending_frames--;
+    return true;
+}
+
+void renderFrame() {
+    timeline::Zone frame("frame");
 
     // Start the Dear ImGui frame
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_NewFrame();
     ImGui::NewFrame();
 
-    g_gui->renderUI();
+    {
+        timeline::Zone zone("renderUI");
+        g_gui->renderUI();
+    }
 
     // Rendering
     ImGui::Render();
@@ -77,11 +112,101 @@ void main_loop_iteration() {
     glClear(GL_COLOR_BUFFER_BIT);
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
-    glfwSwapBuffers(g_window);
+    {
+        timeline::Zone zone("swap");  // blocks on vsync
+        glfwSwapBuffers(g_window);
+    }
+    g_next_tick = glfwGetTime() + g_gui->idleTimeout();
+}
+
+#ifdef __EMSCRIPTEN__
+#ifdef SUDOKUX_STARTUP_LOG
+// performance.now(), milliseconds since the navigation started
+double pageTime() { return EM_ASM_DOUBLE({ return performance.now(); }); }
+#endif
+
+bool g_first_frame = true;
+#endif
+
+#ifdef SUDOKUX_LAZY_FONTS
+// ------------------------
+// Lazy fonts: nothing is preloaded, so the first frame draws with ImGui's built-in font
+// while the UI fonts download. Once both files are in the filesystem they are added
+// between two frames and the font texture is rebuilt.
+// ------------------------
+
+int g_fonts_to_fetch = -1;  // -1 until the fetch starts
+bool g_fonts_installed = false;
+
+void fetchFonts() {
+    static const std::string files[] = {std::string(FONT_DIR) + MAIN_FONT_FILE, std::string(FONT_DIR) + HEADING_FONT_FILE};
+
+    mkdir("assets", 0777);
+    mkdir("assets/font", 0777);
+    g_fonts_to_fetch = 2;
+    for (const std::string& file : files) {
+        emscripten_async_wget(
+            file.c_str(), file.c_str(),
+            [](const char*) {
+                g_fonts_to_fetch--;
+                requestFrames();
+            },
+            [](const char* file) { printf("Failed to fetch font: %s\n", file); });
+    }
+}
+
+void installFonts() {
+    g_fonts_installed = true;
+    if (!g_gui->loadFonts()) return;
+    ImGui_ImplOpenGL3_DestroyFontsTexture();
+    ImGui_ImplOpenGL3_CreateFontsTexture();
+#ifdef SUDOKUX_STARTUP_LOG
+    printf("Fonts ready at %.0f ms\n", pageTime());
+#endif
+}
+#endif
+
+// Main loop function for emscripten
+#ifdef __EMSCRIPTEN__
+void main_loop_iteration() {
+    if (!g_window || !g_gui)
+        return;
+
+    // the browser cannot block, so requestAnimationFrame keeps calling and idle
+    // iterations return before any ImGui or GL work
+    glfwPollEvents();
+    if (glfwGetWindowAttrib(g_window, GLFW_ICONIFIED) != 0) {
+        return;
+    }
+
+    if (!frameDue()) return;
+#ifdef SUDOKUX_LAZY_FONTS
+    if (g_fonts_to_fetch == 0 && !g_fonts_installed) installFonts();
+#endif
+    renderFrame();
+
+    if (g_first_frame) {
+        g_first_frame = false;
+#ifdef SUDOKUX_STARTUP_LOG
+        printf("First frame at %.0f ms\n", pageTime());
+#endif
+#ifdef SUDOKUX_LAZY_FONTS
+        fetchFonts();
+#endif
+    }
 }
 #endif
 
 int main(int, char**) {
+#ifndef __EMSCRIPTEN__
+    // SUDOKUX_TIMELINE=<file> records the session as a Chrome trace, written on exit
+    const char* timelineFile = timeline::ENABLED ? std::getenv("SUDOKUX_TIMELINE") : nullptr;
+    if (timelineFile) {
+        timeline::nameThread("ui");
+        timeline::start();
+    }
+#endif
+
     glfwSetErrorCallback(glfw_error_callback);
     if (!glfwInit()) return 1;
 
@@ -139,11 +264,16 @@ int main(int, char**) {
     #endif
 
     g_gui = new GUI();
+#ifndef __EMSCRIPTEN__
+    // wakes glfwWaitEvents() when a solve finishes, the browser loop polls every animation frame
+    g_gui->setWakeHandler([]() { glfwPostEmptyEvent(); });
+#endif
 
     // Setup Dear ImGui style
     ImGui::StyleColorsDark();
 
     // Setup Platform/Renderer backends
+    installWakeCallbacks(g_window);  // before the backend so it chains to them
     ImGui_ImplGlfw_InitForOpenGL(g_window, true);
     ImGui_ImplOpenGL3_Init(glsl_version);
 
@@ -157,32 +287,23 @@ int main(int, char**) {
 #else
     while (!glfwWindowShouldClose(g_window))
     {
-        glfwPollEvents();
         if (glfwGetWindowAttrib(g_window, GLFW_ICONIFIED) != 0) {
-            // Sleep to avoid high CPU usage when minimized
-            // Note: ImGui_ImplGlfw_Sleep isn't a standard ImGui function, you might need to implement it
-            // or replace with a platform-specific sleep function
             glfwWaitEvents();
             continue;
         }
 
-        // Start the Dear ImGui frame
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
-        ImGui::NewFrame();
-
-        g_gui->renderUI();
-
-        // Rendering
-        ImGui::Render();
-        int display_w, display_h;
-        glfwGetFramebufferSize(g_window, &display_w, &display_h);
-        glViewport(0, 0, display_w, display_h);
-        glClearColor(g_clear_color.x * g_clear_color.w, g_clear_color.y * g_clear_color.w, g_clear_color.z * g_clear_color.w, g_clear_color.w);
-        glClear(GL_COLOR_BUFFER_BIT);
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        // block until input or the GUI's next tick instead of spinning at vsync rate
+        double wait = g_next_tick - glfwGetTime();
+        if (g_pending_frames > 0 || wait <= 0.0) {
+            glfwPollEvents();
+        } else if (wait == std::numeric_limits<double>::infinity()) {
+            glfwWaitEvents();
+        } else {
+            glfwWaitEventsTimeout(wait);
+        }
 
-        glfwSwapBuffers(g_window);
+        if (!frameDue()) continue;
+        renderFrame();
     }
 #endif
 
@@ -191,9 +312,13 @@ int main(int, char**) {
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
 
-    delete g_gui;
+    delete g_gui;  // joins the solver and pool threads
     glfwDestroyWindow(g_window);
     glfwTerminate();
 
+#ifndef __EMSCRIPTEN__
+    if (timelineFile && !timeline::stop(timelineFile)) fprintf(stderr, "cannot write %s\n", timelineFile);
+#endif
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,104 @@
+#include "perfCounters.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+namespace perf {
+
+const char* counterName(int counter) {
+    static constexpr const char* NAMES[COUNTER_COUNT] = {"cycles", "instructions", "branch-misses", "L1d-misses", "LLC-misses"};
+    return NAMES[counter];
+}
+
+#ifdef __linux__
+
+namespace {
+
+struct Event {
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr Event EVENTS[COUNTER_COUNT] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+};
+
+int openEvent(const Event& event) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = event.type;
+    attr.config = event.config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+}  // namespace
+
+Counters::Counters() {
+    for (int i = 0; i < COUNTER_COUNT; i++) fds[i] = openEvent(EVENTS[i]);
+}
+
+Counters::~Counters() {
+    for (int fd : fds) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+bool Counters::available() const {
+    for (int fd : fds) {
+        if (fd >= 0) return true;
+    }
+    return false;
+}
+
+void Counters::start() {
+    for (int fd : fds) {
+        if (fd < 0) continue;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+void Counters::stop() {
+    for (int fd : fds) {
+        if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+}
+
+Reading Counters::read() const {
+    Reading reading;
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        uint64_t data[3];  // value, time enabled, time running
+        if (fds[i] < 0 || ::read(fds[i], data, sizeof(data)) != sizeof(data) || data[2] == 0) continue;
+        reading.values[i] = static_cast<double>(data[0]) * data[1] / data[2];
+        reading.valid[i] = true;
+    }
+    return reading;
+}
+
+#else
+
+Counters::Counters() { fds.fill(-1); }
+Counters::~Counters() {}
+bool Counters::available() const { return false; }
+void Counters::start() {}
+void Counters::stop() {}
+Reading Counters::read() const { return {}; }
+
+#endif
+
+}  // namespace perf
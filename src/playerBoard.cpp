@@ -0,0 +1,50 @@
+#include "playerBoard.hpp"
+
+void PlayerBoard::count(std::vector<uint8_t>& counts, int unit, int digit, int delta) {
+    uint8_t& n = counts[unit * (size + 1) + digit];
+    if (delta > 0) {
+        if (n > 0) duplicates++;
+        n++;
+    } else {
+        n--;
+        if (n > 0) duplicates--;
+    }
+}
+
+void PlayerBoard::add(int row, int col, int digit, int delta) {
+    if (digit == EMPTY) return;
+    count(rowCounts, row, digit, delta);
+    count(colCounts, col, digit, delta);
+    count(boxCounts, boxOf(row, col), digit, delta);
+    filled += delta;
+}
+
+void PlayerBoard::reset(const std::vector<std::vector<int>>& grid) {
+    size = static_cast<int>(grid.size());
+    box = boxShapeOf(size);
+    rowCounts.assign(size * (size + 1), 0);
+    colCounts.assign(size * (size + 1), 0);
+    boxCounts.assign(size * (size + 1), 0);
+    filled = 0;
+    duplicates = 0;
+    version++;
+
+    for (int row = 0; row < size; row++) {
+        for (int col = 0; col < size; col++) add(row, col, grid[row][col], +1);
+    }
+}
+
+void PlayerBoard::place(std::vector<std::vector<int>>& grid, int row, int col, int digit) {
+    int& cell = grid[row][col];
+    if (cell == digit) return;
+    add(row, col, cell, -1);
+    cell = digit;
+    add(row, col, digit, +1);
+    version++;
+}
+
+bool PlayerBoard::conflicts(int row, int col, int digit) const {
+    if (digit == EMPTY) return false;
+    const int stride = size + 1;
+    return rowCounts[row * stride + digit] > 1 || colCounts[col * stride + digit] > 1 || boxCounts[boxOf(row, col) * stride + digit] > 1;
+}
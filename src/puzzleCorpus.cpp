@@ -0,0 +1,125 @@
+#include "puzzleCorpus.hpp"
+
+#include <cstring>
+
+namespace corpus {
+
+namespace {
+
+constexpr char MAGIC[4] = {'S', 'D', 'X', 'B'};
+
+void putLE(uint8_t* out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) out[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+uint64_t getLE(const uint8_t* in, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; i++) value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    return value;
+}
+
+}  // namespace
+
+// ------------------------
+// Nibble packing: cell 2k in the low nibble of byte k, cell 2k + 1 in the high nibble
+// ------------------------
+
+void pack(const FlatGrid& grid, uint8_t* out) {
+    for (int i = 0; i + 1 < CELLS; i += 2) out[i / 2] = static_cast<uint8_t>(grid[i] | (grid[i + 1] << 4));
+    if (CELLS % 2) out[CELLS / 2] = grid[CELLS - 1];
+}
+
+void unpack(const uint8_t* packed, FlatGrid& grid) {
+    for (int i = 0; i + 1 < CELLS; i += 2) {
+        grid[i] = packed[i / 2] & 0x0F;
+        grid[i + 1] = packed[i / 2] >> 4;
+    }
+    if (CELLS % 2) grid[CELLS - 1] = packed[CELLS / 2] & 0x0F;
+}
+
+// ------------------------
+// Writer
+// ------------------------
+
+CorpusWriter::~CorpusWriter() {
+    if (file.is_open()) close();
+}
+
+void CorpusWriter::writeHeader() {
+    uint8_t header[HEADER_BYTES] = {};
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    putLE(header + 4, FORMAT_VERSION, 2);
+    putLE(header + 6, withSolutions ? FLAG_SOLUTIONS : 0, 2);
+    putLE(header + 8, CELLS, 2);
+    putLE(header + 10, 1 + PACKED_BYTES * (withSolutions ? 2 : 1), 2);
+    putLE(header + 12, count, 8);
+    file.write(reinterpret_cast<const char*>(header), HEADER_BYTES);
+}
+
+bool CorpusWriter::open(const std::string& path, bool solutions) {
+    if (file.is_open()) close();
+
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+
+    withSolutions = solutions;
+    count = 0;
+    writeHeader();  // count is patched in by close()
+    return static_cast<bool>(file);
+}
+
+void CorpusWriter::append(const FlatGrid& puzzle, uint8_t tag) {
+    uint8_t record[1 + 2 * PACKED_BYTES] = {tag};
+    pack(puzzle, record + 1);
+    file.write(reinterpret_cast<const char*>(record), 1 + PACKED_BYTES * (withSolutions ? 2 : 1));
+    count++;
+}
+
+void CorpusWriter::append(const FlatGrid& puzzle, const FlatGrid& solution, uint8_t tag) {
+    if (!withSolutions) {
+        append(puzzle, tag);
+        return;
+    }
+    uint8_t record[1 + 2 * PACKED_BYTES] = {tag};
+    pack(puzzle, record + 1);
+    pack(solution, record + 1 + PACKED_BYTES);
+    file.write(reinterpret_cast<const char*>(record), sizeof(record));
+    count++;
+}
+
+bool CorpusWriter::close() {
+    if (!file.is_open()) return false;
+
+    file.seekp(0);
+    writeHeader();
+    bool ok = static_cast<bool>(file);
+    file.close();
+    return ok;
+}
+
+// ------------------------
+// Reader
+// ------------------------
+
+bool CorpusReader::open(const std::string& path) {
+    records = nullptr;
+    count = 0;
+    if (!file.open(path) || file.size() < HEADER_BYTES) return false;
+
+    const uint8_t* header = reinterpret_cast<const uint8_t*>(file.data());
+    if (std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0) return false;
+    if (getLE(header + 4, 2) != FORMAT_VERSION || getLE(header + 8, 2) != CELLS) return false;
+
+    solutions = getLE(header + 6, 2) & FLAG_SOLUTIONS;
+    recordBytes = getLE(header + 10, 2);
+    if (recordBytes != 1 + PACKED_BYTES * (solutions ? 2 : 1)) return false;
+
+    uint64_t stored = getLE(header + 12, 8);
+    if (stored > (file.size() - HEADER_BYTES) / recordBytes) return false;  // truncated
+
+    records = header + HEADER_BYTES;
+    count = stored;
+    return true;
+}
+
+}  // namespace corpus
@@ -0,0 +1,228 @@
+#include "puzzleIO.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#if defined(__EMSCRIPTEN__) || defined(_WIN32)
+#define SUDOKUX_MMAP 0
+#else
+#define SUDOKUX_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace puzzleIO {
+
+// ------------------------
+// Memory-mapped input
+// ------------------------
+
+MappedFile::MappedFile(const std::string& path) { open(path); }
+
+MappedFile::~MappedFile() { close(); }
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+#if SUDOKUX_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    length = static_cast<size_t>(info.st_size);
+    if (length == 0) {
+        // mmap rejects empty ranges, an empty file is still a valid (empty) input
+        ::close(fd);
+        bytes = "";
+        opened = true;
+        return true;
+    }
+
+    void* region = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // the mapping keeps the file alive
+    if (region == MAP_FAILED) {
+        length = 0;
+        return false;
+    }
+    madvise(region, length, MADV_SEQUENTIAL);
+
+    bytes = static_cast<const char*>(region);
+    mapped = true;
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+
+    fallback.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(fallback.data(), fallback.size())) {
+        fallback.clear();
+        return false;
+    }
+    bytes = fallback.empty() ? "" : fallback.data();
+    length = fallback.size();
+#endif
+
+    opened = true;
+    return true;
+}
+
+void MappedFile::close() {
+#if SUDOKUX_MMAP
+    if (mapped) munmap(const_cast<char*>(bytes), length);
+#endif
+    fallback.clear();
+    bytes = nullptr;
+    length = 0;
+    opened = false;
+    mapped = false;
+}
+
+// ------------------------
+// Cell conversion
+// ------------------------
+
+namespace {
+
+bool isCellChar(char c) { return c == '.' || (c >= '0' && c <= '0' + SIZE); }
+
+}  // namespace
+
+bool parseCells(const char* text, FlatGrid& out) {
+    int i = 0;
+
+#if defined(__SSE2__)
+    const __m128i dot = _mm_set1_epi8('.');
+    const __m128i zeroChar = _mm_set1_epi8('0');
+    const __m128i maxDigit = _mm_set1_epi8(SIZE);
+    __m128i valid = _mm_set1_epi8(-1);
+
+    for (; i + 16 <= CELLS; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+        __m128i isDot = _mm_cmpeq_epi8(chunk, dot);
+        chunk = _mm_or_si128(_mm_andnot_si128(isDot, chunk), _mm_and_si128(isDot, zeroChar));
+
+        // bytes below '0' wrap around to large values, so one unsigned range check covers both ends
+        __m128i digits = _mm_sub_epi8(chunk, zeroChar);
+        valid = _mm_and_si128(valid, _mm_cmpeq_epi8(_mm_min_epu8(digits, maxDigit), digits));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out.data() + i), digits);
+    }
+    if (_mm_movemask_epi8(valid) != 0xFFFF) return false;
+#endif
+
+    for (; i < CELLS; i++) {
+        char c = text[i];
+        if (!isCellChar(c)) return false;
+        out[i] = c == '.' ? EMPTY : static_cast<uint8_t>(c - '0');
+    }
+    return true;
+}
+
+void formatCells(const FlatGrid& grid, char* text) {
+    int i = 0;
+
+#if defined(__SSE2__)
+    const __m128i zeroChar = _mm_set1_epi8('0');
+    for (; i + 16 <= CELLS; i += 16) {
+        __m128i digits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(grid.data() + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(text + i), _mm_add_epi8(digits, zeroChar));
+    }
+#endif
+
+    for (; i < CELLS; i++) text[i] = static_cast<char>('0' + grid[i]);
+}
+
+// ------------------------
+// Reader
+// ------------------------
+
+bool PuzzleReader::next(FlatGrid& grid) {
+    while (cursor < end) {
+        const char* newline = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+        const char* lineEnd = newline ? newline : end;
+        const char* line = cursor;
+        cursor = newline ? newline + 1 : end;
+
+        size_t length = lineEnd - line;
+        if (length == 0 || line[0] == '#' || (length == 1 && line[0] == '\r')) continue;  // blank or comment
+
+        // the cells must be followed by a separator, not by more cell characters
+        if (length >= CELLS && (length == CELLS || !isCellChar(line[CELLS])) && parseCells(line, grid)) return true;
+        skippedLines++;
+    }
+    return false;
+}
+
+// ------------------------
+// Buffered writer
+// ------------------------
+
+PuzzleWriter::PuzzleWriter() : buffer(BUFFER_SIZE) {}
+
+PuzzleWriter::PuzzleWriter(std::FILE* file) : file(file), buffer(BUFFER_SIZE) {}
+
+PuzzleWriter::~PuzzleWriter() {
+    flush();
+    if (ownsFile) std::fclose(file);
+}
+
+bool PuzzleWriter::open(const std::string& path) {
+    flush();
+    if (ownsFile) std::fclose(file);
+
+    file = std::fopen(path.c_str(), "wb");
+    ownsFile = file != nullptr;
+    failed = file == nullptr;
+    return file != nullptr;
+}
+
+char* PuzzleWriter::reserve(size_t bytes) {
+    if (used + bytes > buffer.size()) flush();
+    char* out = buffer.data() + used;
+    used += bytes;
+    return out;
+}
+
+void PuzzleWriter::write(const FlatGrid& grid) {
+    char* out = reserve(CELLS + 1);
+    formatCells(grid, out);
+    out[CELLS] = '\n';
+}
+
+void PuzzleWriter::write(const FlatGrid& puzzle, const FlatGrid& solution) {
+    char* out = reserve(2 * CELLS + 2);
+    formatCells(puzzle, out);
+    out[CELLS] = ',';
+    formatCells(solution, out + CELLS + 1);
+    out[2 * CELLS + 1] = '\n';
+}
+
+void PuzzleWriter::write(const char* text, size_t length) {
+    if (length > buffer.size()) {
+        flush();
+        if (file && std::fwrite(text, 1, length, file) != length) failed = true;
+        return;
+    }
+    std::memcpy(reserve(length), text, length);
+}
+
+bool PuzzleWriter::flush() {
+    if (used > 0) {
+        if (!file || std::fwrite(buffer.data(), 1, used, file) != used) failed = true;
+        used = 0;
+    }
+    if (file && std::fflush(file) != 0) failed = true;
+    return !failed;
+}
+
+}  // namespace puzzleIO
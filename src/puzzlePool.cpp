@@ -0,0 +1,146 @@
+#include "puzzlePool.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+#include "puzzleCorpus.hpp"
+#include "timeline.hpp"
+
+void PuzzlePool::start(int workerCount) {
+    for (int i = 0; i < workerCount; i++) {
+        workers.emplace_back(&PuzzlePool::workerLoop, this);
+    }
+}
+
+PuzzlePool::~PuzzlePool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    refill.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+// difficulty whose ring is furthest from full (counting puzzles still being generated), -1 if all are full
+int PuzzlePool::neediestDifficulty() const {
+    int neediest = -1;
+    int lowest = POOL_CAPACITY;
+    for (int d = 0; d < POOL_DIFFICULTIES; d++) {
+        int pending = rings[d].count + rings[d].inFlight;
+        if (pending < lowest) {
+            lowest = pending;
+            neediest = d;
+        }
+    }
+    return neediest;
+}
+
+bool PuzzlePool::pushLocked(int difficulty, Puzzle&& puzzle, const canonical::Hash128& key) {
+    Ring& ring = rings[difficulty];
+    if (ring.count == POOL_CAPACITY) return false;
+    for (int k = 0; k < ring.count; k++) {
+        if (ring.keys[(ring.head + k) % POOL_CAPACITY] == key) return false;
+    }
+
+    int slot = (ring.head + ring.count) % POOL_CAPACITY;
+    ring.slots[slot] = std::move(puzzle);
+    ring.keys[slot] = key;
+    ring.count++;
+    return true;
+}
+
+void PuzzlePool::workerLoop() {
+    timeline::nameThread("puzzle pool");
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true) {
+        refill.wait(lock, [this]() { return stopping || neediestDifficulty() != -1; });
+        if (stopping) return;
+
+        int difficulty = neediestDifficulty();
+        rings[difficulty].inFlight++;
+
+        lock.unlock();
+        Puzzle puzzle = difficulty < IMPOSSIBLE_DIFFICULTY ? makeRatedPuzzle(difficulty) : makePuzzle(difficulty);
+        canonical::Hash128 key = canonical::canonicalHash(flatten(puzzle.grid));
+        lock.lock();
+
+        rings[difficulty].inFlight--;
+        // a rated dig that ran out of attempts fills the ring of the tier it reached instead
+        int ring = puzzle.tier >= 0 ? std::min(puzzle.tier, IMPOSSIBLE_DIFFICULTY) : difficulty;
+        pushLocked(ring, std::move(puzzle), key);
+    }
+}
+
+bool PuzzlePool::pop(int difficulty, Puzzle& out) {
+    if (difficulty < 0 || difficulty >= POOL_DIFFICULTIES) return false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Ring& ring = rings[difficulty];
+        if (ring.count == 0) return false;
+
+        out = std::move(ring.slots[ring.head]);
+        ring.head = (ring.head + 1) % POOL_CAPACITY;
+        ring.count--;
+    }
+    refill.notify_one();
+    return true;
+}
+
+int PuzzlePool::size(int difficulty) {
+    if (difficulty < 0 || difficulty >= POOL_DIFFICULTIES) return 0;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return rings[difficulty].count;
+}
+
+// ------------------------
+// Persistence as a binary corpus, the record tag holds the difficulty
+// ------------------------
+
+bool PuzzlePool::save(const std::string& path) {
+    corpus::CorpusWriter writer;
+    if (!writer.open(path, false)) return false;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int d = 0; d < POOL_DIFFICULTIES; d++) {
+        const Ring& ring = rings[d];
+        for (int k = 0; k < ring.count; k++) {
+            const Puzzle& puzzle = ring.slots[(ring.head + k) % POOL_CAPACITY];
+            writer.append(flatten(puzzle.grid), static_cast<uint8_t>(d));
+        }
+    }
+    return writer.close();
+}
+
+bool PuzzlePool::load(const std::string& path) {
+    corpus::CorpusReader reader;
+    if (!reader.open(path)) return false;
+
+    int loaded = 0;
+    for (size_t i = 0; i < reader.size(); i++) {
+        int difficulty = reader.tag(i);
+        if (difficulty >= POOL_DIFFICULTIES) continue;
+
+        FlatGrid cells;
+        reader.puzzle(i, cells);
+        if (std::any_of(cells.begin(), cells.end(), [](uint8_t num) { return num > SIZE; })) continue;
+
+        Puzzle puzzle;
+        unflatten(cells, puzzle.grid);
+        puzzle.givens.assign(SIZE, std::vector<bool>(SIZE, false));
+        for (int cell = 0; cell < CELLS; cell++) {
+            if (cells[cell] != EMPTY) puzzle.givens[cell / SIZE][cell % SIZE] = true;
+        }
+
+        canonical::Hash128 key = canonical::canonicalHash(cells);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (pushLocked(difficulty, std::move(puzzle), key)) loaded++;
+    }
+
+    std::cout << "Loaded " << loaded << " pre-generated puzzles from " << path << "\n";
+    return true;
+}
@@ -0,0 +1,213 @@
+#include <charconv>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "engineService.hpp"
+#include "httpServer.hpp"
+#include "puzzleIO.hpp"
+#include "workerPool.hpp"
+
+// ------------------------
+// sudokuServer: the engines behind a loopback HTTP/JSON API.
+//   POST /solve     body: {"puzzle":"..."}, {"puzzles":["...",...]} or one puzzle per line
+//                   -> {"solutions":["...",null,...]}  (null = no solution)
+//   POST /rate      same body -> {"ratings":[{"givens":..,"solutions":..,"difficulty":..,"score":..,"label":"..","hardest":".."}]}
+//   GET  /generate?difficulty=0..4 -> {"difficulty":N,"puzzle":"..."}
+// Puzzles are CELLS characters, '0' or '.' for holes. Results are in request order; a batch
+// with any entry that is not a puzzle is rejected whole with 400, naming the entry, so a
+// client pairing results by index never gets them shifted.
+// ------------------------
+
+namespace {
+
+constexpr const char* POOL_FILE = "puzzlePool.bin";
+constexpr size_t CACHE_CAPACITY = 1 << 16;
+
+HttpServer* g_server = nullptr;
+
+void handleSignal(int) {
+    if (g_server) g_server->stop();
+}
+
+HttpResponse errorResponse(int status, const std::string& message) {
+    HttpResponse response{status, "application/json", "{\"error\":"};
+    appendJsonString(response.body, message);
+    response.body += '}';
+    return response;
+}
+
+// the whole of text as a decimal int, false on anything else
+bool parseInt(const std::string& text, int& value) {
+    const char* end = text.data() + text.size();
+    auto [parsed, error] = std::from_chars(text.data(), end, value);
+    return error == std::errc() && parsed == end;
+}
+
+// JSON bodies: every string value is an entry, so both the "puzzle" and "puzzles" forms work
+// without a JSON parser; strings followed by ':' are keys. Anything else is read as lines.
+// False with error set if an entry is not a puzzle.
+bool parsePuzzles(const std::string& body, std::vector<FlatGrid>& puzzles, std::string& error) {
+    FlatGrid grid;
+
+    size_t first = body.find_first_not_of(" \t\r\n");
+    if (first != std::string::npos && body[first] == '{') {
+        for (size_t open = body.find('"'); open != std::string::npos;) {
+            size_t close = open + 1;
+            while (close < body.size() && body[close] != '"') close += body[close] == '\\' ? 2 : 1;
+            if (close >= body.size()) {
+                error = "unterminated string";
+                return false;
+            }
+
+            size_t next = body.find_first_not_of(" \t\r\n", close + 1);
+            bool isKey = next != std::string::npos && body[next] == ':';
+            if (!isKey) {
+                if (close - open - 1 != CELLS || !puzzleIO::parseCells(body.data() + open + 1, grid)) {
+                    error = "entry " + std::to_string(puzzles.size()) + " is not a puzzle";
+                    return false;
+                }
+                puzzles.push_back(grid);
+            }
+            open = body.find('"', close + 1);
+        }
+        return true;
+    }
+
+    puzzleIO::PuzzleReader reader(body.data(), body.size());
+    while (reader.next(grid)) puzzles.push_back(grid);
+    if (reader.skipped() > 0) {
+        error = std::to_string(reader.skipped()) + " malformed lines";
+        return false;
+    }
+    return true;
+}
+
+void appendGrid(std::string& out, const FlatGrid& grid) {
+    char text[CELLS];
+    puzzleIO::formatCells(grid, text);
+    out += '"';
+    out.append(text, CELLS);
+    out += '"';
+}
+
+HttpResponse handleSolve(EngineService& engine, const HttpRequest& request) {
+    std::vector<FlatGrid> puzzles;
+    std::string error;
+    if (!parsePuzzles(request.body, puzzles, error)) return errorResponse(400, error);
+    if (puzzles.empty()) return errorResponse(400, "no puzzle in body");
+
+    std::string body = "{\"solutions\":[";
+    body.reserve(body.size() + puzzles.size() * (CELLS + 3));
+    FlatGrid solution;
+    for (size_t i = 0; i < puzzles.size(); i++) {
+        if (i > 0) body += ',';
+        if (engine.solve(puzzles[i], solution)) {
+            appendGrid(body, solution);
+        } else {
+            body += "null";
+        }
+    }
+    body += "]}";
+    return {200, "application/json", std::move(body)};
+}
+
+HttpResponse handleRate(EngineService& engine, const HttpRequest& request) {
+    std::vector<FlatGrid> puzzles;
+    std::string error;
+    if (!parsePuzzles(request.body, puzzles, error)) return errorResponse(400, error);
+    if (puzzles.empty()) return errorResponse(400, "no puzzle in body");
+
+    std::string body = "{\"ratings\":[";
+    for (size_t i = 0; i < puzzles.size(); i++) {
+        Rating rating = engine.rate(puzzles[i]);
+        if (i > 0) body += ',';
+        body += "{\"givens\":" + std::to_string(rating.givens) + ",\"solutions\":" + std::to_string(rating.solutions) +
+                ",\"difficulty\":" + std::to_string(rating.difficulty) + ",\"score\":" + std::to_string(rating.score) + ",\"label\":\"" +
+                rating.label + "\",\"hardest\":\"" + rating.hardest + "\"}";
+    }
+    body += "]}";
+    return {200, "application/json", std::move(body)};
+}
+
+HttpResponse handleGenerate(EngineService& engine, const HttpRequest& request) {
+    std::string value = queryParameter(request.query, "difficulty");
+    int difficulty = 0;
+    if (!value.empty() && !parseInt(value, difficulty)) return errorResponse(400, "difficulty must be a number");
+    if (difficulty < 0 || difficulty >= SERVICE_DIFFICULTIES) return errorResponse(422, "difficulty must be 0-4");
+
+    std::string body = "{\"difficulty\":" + std::to_string(difficulty) + ",\"puzzle\":";
+    appendGrid(body, engine.generate(difficulty));
+    body += '}';
+    return {200, "application/json", std::move(body)};
+}
+
+HttpResponse route(EngineService& engine, const HttpRequest& request) {
+    if (request.path == "/solve" || request.path == "/rate") {
+        if (request.method != "POST") return errorResponse(405, "use POST");
+        return request.path == "/solve" ? handleSolve(engine, request) : handleRate(engine, request);
+    }
+    if (request.path == "/generate") {
+        if (request.method != "GET" && request.method != "POST") return errorResponse(405, "use GET");
+        return handleGenerate(engine, request);
+    }
+    return errorResponse(404, "unknown path");
+}
+
+void printUsage(const char* program) {
+    std::cerr << "usage: " << program << " [--port N] [--threads N] [--pool-workers N]\n"
+              << "  --port          TCP port on 127.0.0.1 (default 8080)\n"
+              << "  --threads       request worker threads, 0 = one per hardware thread (default 0)\n"
+              << "  --pool-workers  background puzzle generators, 0 disables the pool (default 1)\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int port = 8080;
+    int threads = 0;
+    int poolWorkers = 1;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--port") == 0 && hasValue) {
+            port = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--pool-workers") == 0 && hasValue) {
+            poolWorkers = std::atoi(argv[++i]);
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+    if (port <= 0 || port > 65535) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    EngineService engine(CACHE_CAPACITY);
+    if (poolWorkers > 0) {
+        engine.loadPool(POOL_FILE);
+        engine.startPool(poolWorkers);
+    }
+
+    WorkerPool workers(threads);
+    HttpServer server(workers, [&engine](const HttpRequest& request) { return route(engine, request); });
+    if (!server.listen(static_cast<uint16_t>(port))) return 1;
+
+    g_server = &server;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::cerr << "listening on http://127.0.0.1:" << port << " with " << workers.size() << " worker threads\n";
+    server.run();
+    g_server = nullptr;
+
+    if (poolWorkers > 0) engine.savePool(POOL_FILE);
+    return 0;
+}
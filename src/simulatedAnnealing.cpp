@@ -2,55 +2,135 @@
 
 #include <algorithm>
 #include <array>
+#include <bitset>
 #include <chrono>
 #include <cmath>
+#include <cstring>
 #include <iostream>
+#include <memory>
 #include <random>
-#include <unordered_set>
 #include <vector>
 
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
+
 #include "constants.hpp"
+#include "timeline.hpp"
 
 namespace simulatedAnnealing {
 
-int calculateScore(std::vector<std::vector<int>>& grid) {
-    int score = 0;
+void solve(std::vector<std::vector<int>>& grid, std::vector<std::vector<bool>>& givens, trace::Recorder* trace) {
+    withBoard(static_cast<int>(grid.size()), [&](auto board) {
+        for (int i = 0; i < board.size; i++) {
+            for (int j = 0; j < board.size; j++) {
+                board.at(i, j) = givens[i][j] ? grid[i][j] : EMPTY;
+            }
+        }
+        solve(board, trace);
+        board.toGrid(grid);
+    });
+}
 
-    for (int i = 0; i < SIZE; i++) {
-        std::array<bool, SIZE + 1> rowCheck = {};
-        std::array<bool, SIZE + 1> colCheck = {};
+namespace {
 
-        for (int j = 0; j < SIZE; j++) {
-            rowCheck[grid[i][j]] = true;
-            colCheck[grid[j][i]] = true;
-        }
+#ifdef __wasm_simd128__
+// ------------------------
+// simd128 scoring for boards narrower than 16: a row is one vector and its values become bit
+// masks through two byte-table swizzles (value v -> bit v, low byte and high byte). Column
+// masks are OR-ed lane-wise across rows, row masks OR-reduced across lanes, and i8x16.popcnt
+// counts the distinct values of both.
+// ------------------------
+
+template <class B>
+v128_t loadRow(const B& board, int row) {
+    const uint8_t* cells = board.cells.data() + row * B::size;
+    if (row * B::size + 16 <= B::cellCount) return wasm_v128_load(cells);
+
+    // the last rows would read past the board
+    alignas(16) uint8_t padded[16] = {};
+    std::memcpy(padded, cells, B::size);
+    return wasm_v128_load(padded);
+}
+
+template <class B>
+int distinctValuesSimd(const B& board) {
+    const v128_t lowBits = wasm_u8x16_make(1, 2, 4, 8, 16, 32, 64, 128, 0, 0, 0, 0, 0, 0, 0, 0);
+    const v128_t highBits = wasm_u8x16_make(0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, 128);
+    // a 16-byte load runs into the next row, those lanes are dropped
+    const v128_t inRow = wasm_u8x16_lt(wasm_u8x16_make(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), wasm_u8x16_splat(B::size));
+
+    v128_t colLow = wasm_u8x16_splat(0), colHigh = wasm_u8x16_splat(0);
+    int distinct = 0;
+
+    for (int row = 0; row < B::size; row++) {
+        v128_t values = loadRow(board, row);
+        v128_t low = wasm_v128_and(wasm_i8x16_swizzle(lowBits, values), inRow);
+        v128_t high = wasm_v128_and(wasm_i8x16_swizzle(highBits, values), inRow);
+        colLow = wasm_v128_or(colLow, low);
+        colHigh = wasm_v128_or(colHigh, high);
 
-        score += SIZE - std::count(rowCheck.begin(), rowCheck.end(), true);
-        score += SIZE - std::count(colCheck.begin(), colCheck.end(), true);
+        // fold 16 lanes to 8, pack low | high side by side, then fold each half down to one lane
+        low = wasm_v128_or(low, wasm_i8x16_shuffle(low, low, 8, 9, 10, 11, 12, 13, 14, 15, 8, 9, 10, 11, 12, 13, 14, 15));
+        high = wasm_v128_or(high, wasm_i8x16_shuffle(high, high, 8, 9, 10, 11, 12, 13, 14, 15, 8, 9, 10, 11, 12, 13, 14, 15));
+        v128_t packed = wasm_i8x16_shuffle(low, high, 0, 1, 2, 3, 4, 5, 6, 7, 16, 17, 18, 19, 20, 21, 22, 23);
+        packed = wasm_v128_or(packed, wasm_i8x16_shuffle(packed, packed, 4, 5, 6, 7, 4, 5, 6, 7, 12, 13, 14, 15, 12, 13, 14, 15));
+        packed = wasm_v128_or(packed, wasm_i8x16_shuffle(packed, packed, 2, 3, 2, 3, 2, 3, 2, 3, 10, 11, 10, 11, 10, 11, 10, 11));
+        packed = wasm_v128_or(packed, wasm_i8x16_shuffle(packed, packed, 1, 1, 1, 1, 1, 1, 1, 1, 9, 9, 9, 9, 9, 9, 9, 9));
+
+        v128_t counts = wasm_i8x16_popcnt(packed);
+        distinct += wasm_u8x16_extract_lane(counts, 0) + wasm_u8x16_extract_lane(counts, 8);
     }
 
-    return score;
+    v128_t counts = wasm_i8x16_add(wasm_i8x16_popcnt(colLow), wasm_i8x16_popcnt(colHigh));
+    v128_t sums = wasm_u32x4_extadd_pairwise_u16x8(wasm_u16x8_extadd_pairwise_u8x16(counts));
+    distinct += wasm_i32x4_extract_lane(sums, 0) + wasm_i32x4_extract_lane(sums, 1) + wasm_i32x4_extract_lane(sums, 2) + wasm_i32x4_extract_lane(sums, 3);
+    return distinct;
 }
+#endif
 
-void randomizeGrid(std::vector<std::vector<int>>& grid) {
-    std::unordered_set<int> givenNumbers;
-    auto rng = std::mt19937(std::chrono::high_resolution_clock::now().time_since_epoch().count());
-
-    for (int boxRow = 0; boxRow < 3; boxRow++) {
-        for (int boxCol = 0; boxCol < 3; boxCol++) {
-            givenNumbers.clear();
-            for (int i = 0; i < 3; i++) {
-                for (int j = 0; j < 3; j++) {
-                    int element = grid[boxRow * 3 + i][boxCol * 3 + j];
-                    if (element != EMPTY) {
-                        givenNumbers.emplace(element);
-                    }
+// Scalar path: one bit per value seen, EMPTY included
+template <class B>
+int distinctValuesScalar(const B& board) {
+    int distinct = 0;
+
+    for (int i = 0; i < B::size; i++) {
+        uint32_t rowSeen = 0, colSeen = 0;
+        for (int j = 0; j < B::size; j++) {
+            rowSeen |= 1u << board.at(i, j);
+            colSeen |= 1u << board.at(j, i);
+        }
+        distinct += static_cast<int>(std::bitset<32>(rowSeen).count() + std::bitset<32>(colSeen).count());
+    }
+
+    return distinct;
+}
+
+}  // namespace
+
+// Each row and column scores the values it is missing
+template <class B>
+int calculateScore(const B& board) {
+#ifdef __wasm_simd128__
+    if constexpr (B::size < 16) return 2 * B::cellCount - distinctValuesSimd(board);
+#endif
+    return 2 * B::cellCount - distinctValuesScalar(board);
+}
+
+template <class B>
+void randomizeGrid(B& board, std::mt19937& rng) {
+    for (int boxRow = 0; boxRow < B::boxCols; boxRow++) {
+        for (int boxCol = 0; boxCol < B::boxRows; boxCol++) {
+            std::array<bool, B::size + 1> givenNumbers = {};
+            for (int i = 0; i < B::boxRows; i++) {
+                for (int j = 0; j < B::boxCols; j++) {
+                    givenNumbers[board.at(boxRow * B::boxRows + i, boxCol * B::boxCols + j)] = true;
                 }
             }
 
             std::vector<int> values;
-            for (int i = 1; i <= SIZE; i++) {
-                if (givenNumbers.count(i) == 0) {
+            for (int i = 1; i <= B::size; i++) {
+                if (!givenNumbers[i]) {
                     values.emplace_back(i);
                 }
             }
@@ -58,11 +138,11 @@ void randomizeGrid(std::vector<std::vector<int>>& grid) {
             std::shuffle(values.begin(), values.end(), rng);
 
             int index = 0;
-            for (int i = 0; i < 3; i++) {
-                for (int j = 0; j < 3; j++) {
-                    int element = grid[boxRow * 3 + i][boxCol * 3 + j];
+            for (int i = 0; i < B::boxRows; i++) {
+                for (int j = 0; j < B::boxCols; j++) {
+                    uint8_t& element = board.at(boxRow * B::boxRows + i, boxCol * B::boxCols + j);
                     if (element == EMPTY) {
-                        grid[boxRow * 3 + i][boxCol * 3 + j] = values[index++];
+                        element = values[index++];
                     }
                 }
             }
@@ -70,58 +150,182 @@ void randomizeGrid(std::vector<std::vector<int>>& grid) {
     }
 }
 
-void swapCells(std::vector<std::vector<int>>& grid, std::vector<std::vector<bool>>& givens) {
-    int boxRow = rand() % 3;
-    int boxCol = rand() % 3;
+template <class B>
+bool swapCells(B& board, const FixedCells<B>& fixed, std::mt19937& rng, int& first, int& second) {
+    std::uniform_int_distribution<int> boxRowDist(0, B::boxCols - 1), boxColDist(0, B::boxRows - 1);
+    std::uniform_int_distribution<int> rowDist(0, B::boxRows - 1), colDist(0, B::boxCols - 1);
+
+    int boxRow = boxRowDist(rng);
+    int boxCol = boxColDist(rng);
+
+    // a box with fewer than two free cells has nothing to swap
+    int freeCells = 0;
+    for (int i = 0; i < B::boxRows; i++) {
+        for (int j = 0; j < B::boxCols; j++) {
+            freeCells += !fixed[(boxRow * B::boxRows + i) * B::size + boxCol * B::boxCols + j];
+        }
+    }
+    if (freeCells < 2) return false;
 
     int row1, col1, row2, col2;
 
     do {
-        row1 = boxRow * 3 + rand() % 3;
-        col1 = boxCol * 3 + rand() % 3;
-    } while (givens[row1][col1] != 0);
+        row1 = boxRow * B::boxRows + rowDist(rng);
+        col1 = boxCol * B::boxCols + colDist(rng);
+    } while (fixed[row1 * B::size + col1]);
 
     do {
-        row2 = boxRow * 3 + rand() % 3;
-        col2 = boxCol * 3 + rand() % 3;
-    } while (givens[row2][col2] != 0);
+        row2 = boxRow * B::boxRows + rowDist(rng);
+        col2 = boxCol * B::boxCols + colDist(rng);
+    } while (fixed[row2 * B::size + col2]);
 
-    std::swap(grid[row1][col1], grid[row2][col2]);
+    std::swap(board.at(row1, col1), board.at(row2, col2));
+    first = row1 * B::size + col1;
+    second = row2 * B::size + col2;
+    return first != second;
 }
 
-void solve(std::vector<std::vector<int>>& grid, std::vector<std::vector<bool>>& givens) {
-    randomizeGrid(grid);
-    int currentScore = calculateScore(grid);
-    auto bestState = grid;
-    int bestScore = currentScore;
+namespace {
+
+// ------------------------
+// One annealing run advanced an iteration at a time, shared by solve() and the resumable task
+// ------------------------
+
+template <class B>
+class Annealing {
+   private:
+    B& board;
+    trace::Recorder* trace;
+    FixedCells<B> fixed;
+    std::mt19937 rng;
+    std::uniform_real_distribution<double> probDist{0.0, 1.0};
+    int currentScore;
+    B bestState;
+    int bestScore;
     double temperature = INITIAL_TEMPERATURE;
+    int iteration = 0;
 
-    std::mt19937 rng(std::chrono::high_resolution_clock::now().time_since_epoch().count());
-    std::uniform_real_distribution<double> probDist(0.0, 1.0);
+   public:
+    Annealing(B& board, trace::Recorder* trace) : board(board), trace(trace), rng(std::chrono::high_resolution_clock::now().time_since_epoch().count()) {
+        for (int cell = 0; cell < B::cellCount; cell++) fixed[cell] = board.cells[cell] != EMPTY;
 
-    for (int i = 0; i < MAX_ITERATIONS; ++i) {
-        auto nextState = grid;
-        swapCells(nextState, givens);
+        randomizeGrid(board, rng);
+        if (trace) {
+            for (int cell = 0; cell < B::cellCount; cell++) {
+                if (!fixed[cell]) trace->place(cell, board.cells[cell]);
+            }
+        }
+        currentScore = calculateScore(board);
+        bestState = board;
+        bestScore = currentScore;
+    }
+
+    // one iteration, false once the board is solved or the iterations are spent
+    bool step() {
+        if (iteration >= MAX_ITERATIONS) return false;
+
+        B nextState = board;
+        int first, second;
+        bool swapped = swapCells(nextState, fixed, rng, first, second);
         int nextScore = calculateScore(nextState);
-        int delta = currentScore - nextScore; 
+        int delta = currentScore - nextScore;
 
-        if (delta > 0 || exp(delta / temperature) > probDist(rng)) {
-            grid = nextState;
+        bool accepted = delta > 0 || exp(delta / temperature) > probDist(rng);
+        stats::move(accepted);
+        if (accepted) {
+            board = nextState;
             currentScore = nextScore;
 
-            if (currentScore < bestScore) { 
+            if (trace && swapped) {
+                trace->remove(first, board.cells[second]);
+                trace->remove(second, board.cells[first]);
+                trace->place(first, board.cells[first]);
+                trace->place(second, board.cells[second]);
+            }
+
+            if (currentScore < bestScore) {
                 bestScore = currentScore;
-                bestState = grid;
+                bestState = board;
             }
         }
 
-        if (currentScore == 0) break;  // Perfect solution found
+        if (currentScore == 0) return false;  // Perfect solution found
 
         temperature *= COOLING_RATE;
+        iteration++;
+        return true;
+    }
+
+    // Restore best found state
+    void finish() {
+        if (trace) {
+            // the replay has to end on the board that is returned
+            for (int cell = 0; cell < B::cellCount; cell++) {
+                if (board.cells[cell] != bestState.cells[cell]) trace->remove(cell, board.cells[cell]);
+            }
+            for (int cell = 0; cell < B::cellCount; cell++) {
+                if (board.cells[cell] != bestState.cells[cell]) trace->place(cell, bestState.cells[cell]);
+            }
+        }
+
+        board = bestState;
     }
+};
 
-    grid = bestState;  // Restore best found state
+// one step per iteration
+template <class B>
+class AnnealingTask : public SolveTask {
+   private:
+    B board;  // declared before annealing, which keeps a reference to it
+    Annealing<B> annealing;
+    bool finished = false;
+
+   public:
+    explicit AnnealingTask(const B& puzzle) : board(puzzle), annealing(board, nullptr) {}
+
+    bool run(long steps) override {
+        while (!finished && steps-- > 0) {
+            if (!annealing.step()) {
+                annealing.finish();
+                finished = true;
+            }
+        }
+        return finished;
+    }
+
+    void result(std::vector<std::vector<int>>& grid) const override { board.toGrid(grid); }
+};
+
+}  // namespace
+
+template <class B>
+void solve(B& board, trace::Recorder* trace) {
+    timeline::Zone zone("anneal");
+    Annealing<B> annealing(board, trace);
+    while (annealing.step()) {
+    }
+    annealing.finish();
+}
+
+std::unique_ptr<SolveTask> makeSolveTask(const std::vector<std::vector<int>>& grid, const std::vector<std::vector<bool>>& givens) {
+    std::unique_ptr<SolveTask> task;
+    withBoard(static_cast<int>(grid.size()), [&](auto board) {
+        for (int i = 0; i < board.size; i++) {
+            for (int j = 0; j < board.size; j++) {
+                board.at(i, j) = givens[i][j] ? grid[i][j] : EMPTY;
+            }
+        }
+        task = std::make_unique<AnnealingTask<decltype(board)>>(board);
+    });
+    return task;
 }
 
+#define INSTANTIATE_SIMULATED_ANNEALING(B)                                                 \
+    template int calculateScore<B>(const B&);                                              \
+    template void randomizeGrid<B>(B&, std::mt19937&);                                     \
+    template bool swapCells<B>(B&, const FixedCells<B>&, std::mt19937&, int&, int&);       \
+    template void solve<B>(B&, trace::Recorder*);
+SUDOKUX_FOR_EACH_BOARD(INSTANTIATE_SIMULATED_ANNEALING)
+#undef INSTANTIATE_SIMULATED_ANNEALING
 
-}  // namespace simulatedAnnealing
\ No newline at end of file
+}  // namespace simulatedAnnealing
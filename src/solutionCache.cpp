@@ -0,0 +1,105 @@
+#include "solutionCache.hpp"
+
+#include <algorithm>
+
+namespace {
+
+// SA can stop on a best-effort grid, only genuine solutions may enter the cache
+bool isSolutionOf(const FlatGrid& puzzle, const FlatGrid& solution) {
+    uint16_t rows[SIZE] = {}, cols[SIZE] = {}, boxes[SIZE] = {};
+    for (int i = 0; i < CELLS; i++) {
+        int num = solution[i];
+        if (num < 1 || num > SIZE) return false;
+        if (puzzle[i] != EMPTY && puzzle[i] != num) return false;
+
+        int row = i / SIZE, col = i % SIZE;
+        int box = (row / BOX_SIZE) * BOX_SIZE + col / BOX_SIZE;
+        uint16_t bit = 1 << num;
+        if ((rows[row] | cols[col] | boxes[box]) & bit) return false;
+        rows[row] |= bit;
+        cols[col] |= bit;
+        boxes[box] |= bit;
+    }
+    return true;
+}
+
+}  // namespace
+
+SolutionCache::SolutionCache(size_t capacity) : capacity(capacity) {}
+
+SolutionCache::Key SolutionCache::keyOf(const FlatGrid& puzzle) {
+    Key key;
+    int givens = static_cast<int>(std::count_if(puzzle.begin(), puzzle.end(), [](uint8_t num) { return num != EMPTY; }));
+    if (givens < MIN_CACHED_GIVENS) return key;
+
+    key.form = canonical::canonicalize(puzzle);
+    key.cacheable = key.form.exact;
+    key.hash = canonical::hash128(key.form.grid);
+    return key;
+}
+
+bool SolutionCache::lookup(const Key& key, FlatGrid& solution) {
+    if (!key.cacheable) return false;
+
+    FlatGrid canonicalSolution;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key.hash);
+        if (it == index.end() || it->second->puzzle != key.form.grid) {
+            missCount++;
+            return false;
+        }
+        entries.splice(entries.begin(), entries, it->second);
+        canonicalSolution = it->second->solution;
+        hitCount++;
+    }
+
+    symmetry::apply(symmetry::compile(symmetry::inverse(key.form.transform)), canonicalSolution, solution);
+    return true;
+}
+
+void SolutionCache::store(const Key& key, const FlatGrid& puzzle, const FlatGrid& solution) {
+    if (!key.cacheable || !isSolutionOf(puzzle, solution)) return;
+
+    Entry entry{key.hash, key.form.grid, {}};
+    symmetry::apply(symmetry::compile(key.form.transform), solution, entry.solution);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(key.hash);
+    if (it != index.end()) {
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+
+    entries.push_front(entry);
+    index[key.hash] = entries.begin();
+    if (entries.size() > capacity) {
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+}
+
+bool SolutionCache::solve(std::vector<std::vector<int>>& grid, const std::function<void(std::vector<std::vector<int>>&)>& solver) {
+    FlatGrid puzzle = flatten(grid);
+    Key key = keyOf(puzzle);
+
+    FlatGrid solution;
+    if (lookup(key, solution)) {
+        unflatten(solution, grid);
+        return true;
+    }
+
+    solver(grid);
+    store(key, puzzle, flatten(grid));
+    return false;
+}
+
+size_t SolutionCache::hits() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hitCount;
+}
+
+size_t SolutionCache::misses() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return missCount;
+}
@@ -0,0 +1,31 @@
+#include "solverStats.hpp"
+
+namespace stats {
+
+void reset() {
+    detail::counters = SolverStats{};
+    detail::depth = 0;
+}
+
+SolverStats snapshot() { return detail::counters; }
+
+std::string format(const SolverStats& stats) {
+    std::string out = "nodes=" + std::to_string(stats.nodes);
+    auto field = [&out](const char* name, uint64_t value) {
+        if (value == 0) return;
+        out += ' ';
+        out += name;
+        out += '=';
+        out += std::to_string(value);
+    };
+    field("backtracks", stats.backtracks);
+    field("max-depth", stats.maxDepth);
+    field("covers", stats.covers);
+    field("uncovers", stats.uncovers);
+    field("accepted", stats.accepted);
+    field("rejected", stats.rejected);
+    field("eliminations", stats.eliminations);
+    return out;
+}
+
+}  // namespace stats
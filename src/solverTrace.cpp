@@ -0,0 +1,24 @@
+#include "solverTrace.hpp"
+
+#include "constants.hpp"
+
+namespace trace {
+
+Recorder::Recorder(size_t capacity) {
+    size_t rounded = 1;
+    while (rounded < capacity) rounded <<= 1;
+    events.resize(rounded);
+    mask = rounded - 1;
+}
+
+void apply(std::vector<uint8_t>& cells, const Event& event, bool undo) {
+    bool placing = (event.action == Action::Place) != undo;
+    cells[event.cell] = placing ? event.digit : EMPTY;
+}
+
+std::vector<uint8_t> windowStart(const Recorder& recorder, std::vector<uint8_t> endCells) {
+    for (size_t i = recorder.size(); i-- > 0;) apply(endCells, recorder[i], true);
+    return endCells;
+}
+
+}  // namespace trace
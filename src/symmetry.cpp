@@ -0,0 +1,152 @@
+#include "symmetry.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace symmetry {
+
+namespace {
+
+constexpr int PERMUTATIONS = 6;  // BOX_SIZE!
+
+// all orderings of BOX_SIZE lines, indexed 0..5
+constexpr uint8_t LINE_PERMUTATIONS[PERMUTATIONS][BOX_SIZE] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+
+// rows (or cols) from a band order plus one in-band order per band
+std::array<uint8_t, SIZE> buildLines(int bandPerm, const int linePerms[BOX_SIZE]) {
+    std::array<uint8_t, SIZE> lines;
+    for (int band = 0; band < BOX_SIZE; band++) {
+        for (int i = 0; i < BOX_SIZE; i++) {
+            lines[band * BOX_SIZE + i] = LINE_PERMUTATIONS[bandPerm][band] * BOX_SIZE + LINE_PERMUTATIONS[linePerms[band]][i];
+        }
+    }
+    return lines;
+}
+
+std::array<uint8_t, SIZE> invert(const std::array<uint8_t, SIZE>& perm) {
+    std::array<uint8_t, SIZE> inv;
+    for (int i = 0; i < SIZE; i++) inv[perm[i]] = i;
+    return inv;
+}
+
+}  // namespace
+
+Transform identity() {
+    Transform t;
+    std::iota(t.digits.begin(), t.digits.end(), 0);
+    std::iota(t.rows.begin(), t.rows.end(), 0);
+    std::iota(t.cols.begin(), t.cols.end(), 0);
+    t.transpose = false;
+    return t;
+}
+
+Transform randomTransform(std::mt19937& rng) {
+    std::uniform_int_distribution<int> permDist(0, PERMUTATIONS - 1);
+
+    Transform t = identity();
+    std::shuffle(t.digits.begin() + 1, t.digits.end(), rng);
+
+    int rowPerms[BOX_SIZE], colPerms[BOX_SIZE];
+    for (int i = 0; i < BOX_SIZE; i++) {
+        rowPerms[i] = permDist(rng);
+        colPerms[i] = permDist(rng);
+    }
+    t.rows = buildLines(permDist(rng), rowPerms);
+    t.cols = buildLines(permDist(rng), colPerms);
+    t.transpose = rng() & 1;
+    return t;
+}
+
+Transform transformFromIndex(uint64_t index) {
+    Transform t;
+
+    // mixed radix, least significant first: transpose, col perms, row perms, stack, band, digits
+    t.transpose = index % 2;
+    index /= 2;
+
+    int colPerms[BOX_SIZE], rowPerms[BOX_SIZE];
+    for (int i = 0; i < BOX_SIZE; i++) {
+        colPerms[i] = index % PERMUTATIONS;
+        index /= PERMUTATIONS;
+    }
+    for (int i = 0; i < BOX_SIZE; i++) {
+        rowPerms[i] = index % PERMUTATIONS;
+        index /= PERMUTATIONS;
+    }
+    t.cols = buildLines(index % PERMUTATIONS, colPerms);
+    index /= PERMUTATIONS;
+    t.rows = buildLines(index % PERMUTATIONS, rowPerms);
+    index /= PERMUTATIONS;
+
+    // remaining index is the Lehmer code of the digit relabelling
+    std::array<uint8_t, SIZE> unused;
+    std::iota(unused.begin(), unused.end(), 1);
+    uint64_t factorial = 1;
+    for (int i = 2; i < SIZE; i++) factorial *= i;
+
+    t.digits[EMPTY] = EMPTY;
+    for (int i = 0; i < SIZE; i++) {
+        int pick = index / factorial;
+        index %= factorial;
+        if (i < SIZE - 1) factorial /= (SIZE - 1 - i);
+
+        t.digits[i + 1] = unused[pick];
+        std::copy(unused.begin() + pick + 1, unused.begin() + (SIZE - i), unused.begin() + pick);
+    }
+    return t;
+}
+
+Transform inverse(const Transform& transform) {
+    Transform inv;
+    for (int d = 0; d <= SIZE; d++) inv.digits[transform.digits[d]] = d;
+
+    // undoing a transposed transform transposes back, which swaps the roles of the row and col orders
+    inv.transpose = transform.transpose;
+    if (transform.transpose) {
+        inv.rows = invert(transform.cols);
+        inv.cols = invert(transform.rows);
+    } else {
+        inv.rows = invert(transform.rows);
+        inv.cols = invert(transform.cols);
+    }
+    return inv;
+}
+
+CellMap compile(const Transform& transform) {
+    CellMap map;
+    map.digits = transform.digits;
+    for (int r = 0; r < SIZE; r++) {
+        for (int c = 0; c < SIZE; c++) {
+            int srcRow = transform.rows[r];
+            int srcCol = transform.cols[c];
+            map.source[r * SIZE + c] = transform.transpose ? srcCol * SIZE + srcRow : srcRow * SIZE + srcCol;
+        }
+    }
+    return map;
+}
+
+void apply(const CellMap& map, const FlatGrid& in, FlatGrid& out) {
+    for (int i = 0; i < CELLS; i++) {
+        out[i] = map.digits[in[map.source[i]]];
+    }
+}
+
+void apply(const CellMap& map, const FlatGivens& in, FlatGivens& out) {
+    for (int i = 0; i < CELLS; i++) {
+        out[i] = in[map.source[i]];
+    }
+}
+
+void apply(const Transform& transform, std::vector<std::vector<int>>& grid, std::vector<std::vector<bool>>& givens) {
+    CellMap map = compile(transform);
+
+    FlatGrid cells;
+    apply(map, flatten(grid), cells);
+    unflatten(cells, grid);
+
+    FlatGivens mask;
+    apply(map, flattenGivens(givens), mask);
+    unflattenGivens(mask, givens);
+}
+
+}  // namespace symmetry
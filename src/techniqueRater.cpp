@@ -0,0 +1,492 @@
+#include "techniqueRater.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <iterator>
+
+#include "solverStats.hpp"
+#include "timeline.hpp"
+
+namespace rater {
+
+namespace {
+
+constexpr int UNITS = 3 * SIZE;  // rows, then columns, then boxes
+constexpr int PEERS = 2 * (SIZE - 1) + (BOX_SIZE - 1) * (BOX_SIZE - 1);
+constexpr uint16_t ALL_DIGITS = ((1 << SIZE) - 1) << 1;  // bit d set = digit d possible
+
+constexpr int WEIGHTS[TECHNIQUE_COUNT] = {1, 2, 5, 8, 10, 14, 16, 20, 24, 30, 36};
+constexpr int TIERS[TECHNIQUE_COUNT] = {0, 0, 1, 1, 1, 2, 2, 2, 2, 3, 3};
+constexpr const char* NAMES[TECHNIQUE_COUNT] = {"Hidden Single", "Naked Single", "Locked Candidates", "Naked Pair", "Hidden Pair", "Naked Triple",
+                                                "Hidden Triple", "X-Wing",       "XY-Wing",           "Swordfish",  "Simple Coloring"};
+constexpr const char* TIER_NAMES[RATING_TIERS] = {"Easy", "Medium", "Hard", "Evil", "Impossible"};
+
+inline int rowOf(int cell) { return cell / SIZE; }
+inline int colOf(int cell) { return cell % SIZE; }
+inline int boxOf(int cell) { return (rowOf(cell) / BOX_SIZE) * BOX_SIZE + colOf(cell) / BOX_SIZE; }
+
+inline bool sees(int a, int b) { return a != b && (rowOf(a) == rowOf(b) || colOf(a) == colOf(b) || boxOf(a) == boxOf(b)); }
+
+inline int lowestDigit(uint16_t mask) { return __builtin_ctz(mask); }
+inline int bitCount(uint16_t mask) { return __builtin_popcount(mask); }
+
+struct Geometry {
+    uint8_t units[UNITS][SIZE];
+    uint8_t peers[CELLS][PEERS];
+
+    Geometry() {
+        for (int i = 0; i < SIZE; i++) {
+            for (int j = 0; j < SIZE; j++) {
+                units[i][j] = i * SIZE + j;
+                units[SIZE + i][j] = j * SIZE + i;
+                int row = (i / BOX_SIZE) * BOX_SIZE + j / BOX_SIZE;
+                int col = (i % BOX_SIZE) * BOX_SIZE + j % BOX_SIZE;
+                units[2 * SIZE + i][j] = row * SIZE + col;
+            }
+        }
+        for (int cell = 0; cell < CELLS; cell++) {
+            int count = 0;
+            for (int other = 0; other < CELLS; other++) {
+                if (sees(cell, other)) peers[cell][count++] = other;
+            }
+        }
+    }
+};
+
+const Geometry GEOMETRY;
+
+// Calls f(indices) for every k-subset of {0..n-1} in lexicographic order until f returns true
+template <class F>
+bool forEachCombination(int n, int k, F f) {
+    if (k > n) return false;
+    int indices[SIZE];
+    for (int i = 0; i < k; i++) indices[i] = i;
+
+    while (true) {
+        if (f(indices)) return true;
+
+        int i = k - 1;
+        while (i >= 0 && indices[i] == n - k + i) i--;
+        if (i < 0) return false;
+        indices[i]++;
+        for (int j = i + 1; j < k; j++) indices[j] = indices[j - 1] + 1;
+    }
+}
+
+// ------------------------
+// Candidate grid and the techniques. Every technique either makes one step of progress
+// (a placement, or the eliminations of one pattern instance) and returns true, or changes nothing.
+// ------------------------
+
+class Ladder {
+   private:
+    FlatGrid grid;
+    std::array<uint16_t, CELLS> candidates;
+    int remaining = CELLS;
+
+    void place(int cell, int digit) {
+        grid[cell] = static_cast<uint8_t>(digit);
+        candidates[cell] = 0;
+        remaining--;
+        for (int peer : GEOMETRY.peers[cell]) {
+            if (grid[peer] == digit) broken = true;
+            stats::eliminated((candidates[peer] >> digit) & 1);
+            candidates[peer] &= ~(1 << digit);
+            if (grid[peer] == EMPTY && candidates[peer] == 0) broken = true;
+        }
+    }
+
+    // true if anything was removed
+    bool eliminate(int cell, uint16_t mask) {
+        if (!(candidates[cell] & mask)) return false;
+        stats::eliminated(bitCount(candidates[cell] & mask));
+        candidates[cell] &= ~mask;
+        if (candidates[cell] == 0) broken = true;
+        return true;
+    }
+
+    bool nakedSubset(int k);
+    bool hiddenSubset(int k);
+    bool fish(int k);
+
+   public:
+    bool broken = false;  // contradiction: the puzzle has no solution
+
+    explicit Ladder(const FlatGrid& puzzle) {
+        grid.fill(EMPTY);
+        candidates.fill(ALL_DIGITS);
+        for (int cell = 0; cell < CELLS; cell++) {
+            if (puzzle[cell] == EMPTY) continue;
+            if (puzzle[cell] > SIZE || !(candidates[cell] & (1 << puzzle[cell]))) {
+                broken = true;
+                return;
+            }
+            place(cell, puzzle[cell]);
+        }
+    }
+
+    bool solved() const { return remaining == 0 && !broken; }
+
+    bool apply(Technique technique);
+
+    bool hiddenSingle();
+    bool nakedSingle();
+    bool lockedCandidates();
+    bool xyWing();
+    bool simpleColoring();
+};
+
+bool Ladder::apply(Technique technique) {
+    switch (technique) {
+        case Technique::HiddenSingle:
+            return hiddenSingle();
+        case Technique::NakedSingle:
+            return nakedSingle();
+        case Technique::LockedCandidates:
+            return lockedCandidates();
+        case Technique::NakedPair:
+            return nakedSubset(2);
+        case Technique::HiddenPair:
+            return hiddenSubset(2);
+        case Technique::NakedTriple:
+            return nakedSubset(3);
+        case Technique::HiddenTriple:
+            return hiddenSubset(3);
+        case Technique::XWing:
+            return fish(2);
+        case Technique::XYWing:
+            return xyWing();
+        case Technique::Swordfish:
+            return fish(3);
+        case Technique::SimpleColoring:
+            return simpleColoring();
+        default:
+            return false;
+    }
+}
+
+// A digit with a single possible cell in some unit
+bool Ladder::hiddenSingle() {
+    for (const auto& unit : GEOMETRY.units) {
+        uint16_t once = 0, twice = 0, placed = 0;
+        for (int cell : unit) {
+            twice |= once & candidates[cell];
+            once |= candidates[cell];
+            placed |= 1 << grid[cell];
+        }
+        if (((once | placed) & ALL_DIGITS) != ALL_DIGITS) {
+            broken = true;  // a digit has nowhere to go
+            return false;
+        }
+
+        uint16_t singles = once & ~twice;
+        if (!singles) continue;
+
+        int digit = lowestDigit(singles);
+        for (int cell : unit) {
+            if (candidates[cell] & (1 << digit)) {
+                place(cell, digit);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// A cell with a single candidate
+bool Ladder::nakedSingle() {
+    for (int cell = 0; cell < CELLS; cell++) {
+        if (grid[cell] == EMPTY && bitCount(candidates[cell]) == 1) {
+            place(cell, lowestDigit(candidates[cell]));
+            return true;
+        }
+    }
+    return false;
+}
+
+// Pointing: a digit confined to one line inside a box leaves the rest of that line.
+// Claiming: a digit confined to one box inside a line leaves the rest of that box.
+bool Ladder::lockedCandidates() {
+    for (int digit = 1; digit <= SIZE; digit++) {
+        uint16_t bit = 1 << digit;
+
+        for (int box = 0; box < SIZE; box++) {
+            uint16_t rows = 0, cols = 0;
+            for (int cell : GEOMETRY.units[2 * SIZE + box]) {
+                if (candidates[cell] & bit) {
+                    rows |= 1 << rowOf(cell);
+                    cols |= 1 << colOf(cell);
+                }
+            }
+
+            bool changed = false;
+            if (bitCount(rows) == 1) {
+                for (int cell : GEOMETRY.units[lowestDigit(rows)]) {
+                    if (boxOf(cell) != box) changed |= eliminate(cell, bit);
+                }
+            }
+            if (bitCount(cols) == 1) {
+                for (int cell : GEOMETRY.units[SIZE + lowestDigit(cols)]) {
+                    if (boxOf(cell) != box) changed |= eliminate(cell, bit);
+                }
+            }
+            if (changed) return true;
+        }
+
+        for (int line = 0; line < 2 * SIZE; line++) {
+            uint16_t boxes = 0;
+            for (int cell : GEOMETRY.units[line]) {
+                if (candidates[cell] & bit) boxes |= 1 << boxOf(cell);
+            }
+            if (bitCount(boxes) != 1) continue;
+
+            bool changed = false;
+            for (int cell : GEOMETRY.units[2 * SIZE + lowestDigit(boxes)]) {
+                bool inLine = line < SIZE ? rowOf(cell) == line : colOf(cell) == line - SIZE;
+                if (!inLine) changed |= eliminate(cell, bit);
+            }
+            if (changed) return true;
+        }
+    }
+    return false;
+}
+
+// k cells of a unit whose candidates together are exactly k digits: those digits leave the
+// rest of the unit
+bool Ladder::nakedSubset(int k) {
+    for (const auto& unit : GEOMETRY.units) {
+        int open[SIZE];
+        int openCount = 0;
+        for (int cell : unit) {
+            int count = bitCount(candidates[cell]);
+            if (count >= 2 && count <= k) open[openCount++] = cell;
+        }
+
+        bool found = forEachCombination(openCount, k, [&](const int* chosen) {
+            uint16_t digits = 0;
+            for (int i = 0; i < k; i++) digits |= candidates[open[chosen[i]]];
+            if (bitCount(digits) != k) return false;
+
+            bool changed = false;
+            for (int cell : unit) {
+                bool member = false;
+                for (int i = 0; i < k; i++) member |= open[chosen[i]] == cell;
+                if (!member) changed |= eliminate(cell, digits);
+            }
+            return changed;
+        });
+        if (found) return true;
+    }
+    return false;
+}
+
+// k digits of a unit confined to the same k cells: those cells lose every other candidate
+bool Ladder::hiddenSubset(int k) {
+    for (const auto& unit : GEOMETRY.units) {
+        uint16_t positions[SIZE + 1] = {};
+        for (int i = 0; i < SIZE; i++) {
+            for (uint16_t mask = candidates[unit[i]]; mask; mask &= mask - 1) positions[lowestDigit(mask)] |= 1 << i;
+        }
+
+        int digits[SIZE];
+        int digitCount = 0;
+        for (int digit = 1; digit <= SIZE; digit++) {
+            int count = bitCount(positions[digit]);
+            if (count >= 2 && count <= k) digits[digitCount++] = digit;
+        }
+
+        bool found = forEachCombination(digitCount, k, [&](const int* chosen) {
+            uint16_t cells = 0, keep = 0;
+            for (int i = 0; i < k; i++) {
+                cells |= positions[digits[chosen[i]]];
+                keep |= 1 << digits[chosen[i]];
+            }
+            if (bitCount(cells) != k) return false;
+
+            bool changed = false;
+            for (uint16_t mask = cells; mask; mask &= mask - 1) changed |= eliminate(unit[lowestDigit(mask)], ~keep & ALL_DIGITS);
+            return changed;
+        });
+        if (found) return true;
+    }
+    return false;
+}
+
+// X-wing (k = 2) / swordfish (k = 3): a digit confined to the same k columns in k rows leaves
+// those columns everywhere else, and the same with rows and columns swapped
+bool Ladder::fish(int k) {
+    for (int digit = 1; digit <= SIZE; digit++) {
+        uint16_t bit = 1 << digit;
+
+        for (int orientation = 0; orientation < 2; orientation++) {
+            const auto* baseUnits = &GEOMETRY.units[orientation * SIZE];
+            const auto* coverUnits = &GEOMETRY.units[(1 - orientation) * SIZE];
+
+            uint16_t positions[SIZE];
+            int lines[SIZE];
+            int lineCount = 0;
+            for (int line = 0; line < SIZE; line++) {
+                positions[line] = 0;
+                for (int i = 0; i < SIZE; i++) {
+                    if (candidates[baseUnits[line][i]] & bit) positions[line] |= 1 << i;
+                }
+                int count = bitCount(positions[line]);
+                if (count >= 2 && count <= k) lines[lineCount++] = line;
+            }
+
+            bool found = forEachCombination(lineCount, k, [&](const int* chosen) {
+                uint16_t covers = 0, bases = 0;
+                for (int i = 0; i < k; i++) {
+                    covers |= positions[lines[chosen[i]]];
+                    bases |= 1 << lines[chosen[i]];
+                }
+                if (bitCount(covers) != k) return false;
+
+                bool changed = false;
+                for (uint16_t mask = covers; mask; mask &= mask - 1) {
+                    const auto& cover = coverUnits[lowestDigit(mask)];
+                    for (int i = 0; i < SIZE; i++) {
+                        if (!(bases & (1 << i))) changed |= eliminate(cover[i], bit);
+                    }
+                }
+                return changed;
+            });
+            if (found) return true;
+        }
+    }
+    return false;
+}
+
+// Pivot {a,b} seeing pincers {a,c} and {b,c}: c leaves every cell seeing both pincers
+bool Ladder::xyWing() {
+    for (int pivot = 0; pivot < CELLS; pivot++) {
+        uint16_t pivotMask = candidates[pivot];
+        if (bitCount(pivotMask) != 2) continue;
+
+        for (int first : GEOMETRY.peers[pivot]) {
+            uint16_t firstMask = candidates[first];
+            if (bitCount(firstMask) != 2 || bitCount(firstMask & pivotMask) != 1) continue;
+
+            uint16_t target = firstMask & ~pivotMask;
+            uint16_t secondMask = (pivotMask & ~firstMask) | target;
+            for (int second : GEOMETRY.peers[pivot]) {
+                if (candidates[second] != secondMask || second == first) continue;
+
+                bool changed = false;
+                for (int cell : GEOMETRY.peers[first]) {
+                    if (cell != second && sees(cell, second)) changed |= eliminate(cell, target);
+                }
+                if (changed) return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Per digit, cells linked by conjugate pairs (the only two places in a unit) are two-coloured;
+// one colour is the truth. Two same-coloured cells seeing each other make that colour false,
+// and a cell seeing both colours cannot hold the digit.
+bool Ladder::simpleColoring() {
+    for (int digit = 1; digit <= SIZE; digit++) {
+        uint16_t bit = 1 << digit;
+
+        int8_t links[CELLS][3];  // one conjugate partner per unit kind
+        for (auto& cellLinks : links) cellLinks[0] = cellLinks[1] = cellLinks[2] = -1;
+        bool anyLink = false;
+        for (int u = 0; u < UNITS; u++) {
+            int pair[2];
+            int count = 0;
+            for (int cell : GEOMETRY.units[u]) {
+                if ((candidates[cell] & bit) && count++ < 2) pair[count - 1] = cell;
+            }
+            if (count != 2) continue;
+            links[pair[0]][u / SIZE] = static_cast<int8_t>(pair[1]);
+            links[pair[1]][u / SIZE] = static_cast<int8_t>(pair[0]);
+            anyLink = true;
+        }
+        if (!anyLink) continue;
+
+        int8_t colour[CELLS];
+        std::fill(std::begin(colour), std::end(colour), -1);
+        for (int start = 0; start < CELLS; start++) {
+            if (colour[start] != -1 || links[start][0] + links[start][1] + links[start][2] == -3) continue;
+
+            int component[CELLS];
+            int size = 0;
+            component[size++] = start;
+            colour[start] = 0;
+            for (int i = 0; i < size; i++) {
+                for (int8_t next : links[component[i]]) {
+                    if (next >= 0 && colour[next] == -1) {
+                        colour[next] = static_cast<int8_t>(1 - colour[component[i]]);
+                        component[size++] = next;
+                    }
+                }
+            }
+            if (size < 3) continue;  // a lone pair proves nothing
+
+            // colour wrap
+            for (int i = 0; i < size; i++) {
+                for (int j = i + 1; j < size; j++) {
+                    if (colour[component[i]] != colour[component[j]] || !sees(component[i], component[j])) continue;
+
+                    int8_t falseColour = colour[component[i]];
+                    for (int m = 0; m < size; m++) {
+                        if (colour[component[m]] == falseColour) eliminate(component[m], bit);
+                    }
+                    return true;
+                }
+            }
+
+            // colour trap
+            std::bitset<CELLS> inComponent;
+            for (int i = 0; i < size; i++) inComponent.set(component[i]);
+            bool changed = false;
+            for (int cell = 0; cell < CELLS; cell++) {
+                if (!(candidates[cell] & bit) || inComponent.test(cell)) continue;
+                bool seesColour[2] = {false, false};
+                for (int i = 0; i < size; i++) {
+                    if (sees(cell, component[i])) seesColour[colour[component[i]]] = true;
+                }
+                if (seesColour[0] && seesColour[1]) changed |= eliminate(cell, bit);
+            }
+            if (changed) return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+Rating rate(const FlatGrid& puzzle) {
+    timeline::Zone zone("rate");
+    Rating rating{};
+    rating.hardest = Technique::HiddenSingle;
+
+    Ladder ladder(puzzle);
+    while (!ladder.broken && !ladder.solved()) {
+        bool progressed = false;
+        for (int t = 0; t < TECHNIQUE_COUNT && !progressed && !ladder.broken; t++) {
+            Technique technique = static_cast<Technique>(t);
+            if (!ladder.apply(technique)) continue;
+
+            progressed = true;
+            rating.uses[t]++;
+            rating.score += WEIGHTS[t];
+            if (technique > rating.hardest) rating.hardest = technique;
+        }
+        if (!progressed) break;
+    }
+
+    rating.solved = ladder.solved();
+    rating.tier = rating.solved ? tierOf(rating.hardest) : RATING_TIERS - 1;
+    return rating;
+}
+
+int tierOf(Technique technique) { return TIERS[static_cast<int>(technique)]; }
+
+const char* techniqueName(Technique technique) { return NAMES[static_cast<int>(technique)]; }
+
+const char* tierName(int tier) { return tier >= 0 && tier < RATING_TIERS ? TIER_NAMES[tier] : "Invalid"; }
+
+}  // namespace rater
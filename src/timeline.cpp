@@ -0,0 +1,117 @@
+#include "timeline.hpp"
+
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace timeline {
+
+namespace {
+
+struct Event {
+    const char* name;
+    uint64_t start;
+    uint64_t end;
+};
+
+// Owned by the registry rather than the thread, so the events of threads that have exited
+// (a generator's helper digs, a joined pool) are still written
+struct ThreadTrack {
+    std::mutex mutex;  // the thread appends while stop() reads
+    int id;
+    const char* name = nullptr;
+    std::vector<Event> events;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadTrack>> tracks;
+    uint64_t origin = 0;  // start() time, the trace's zero
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+ThreadTrack& localTrack() {
+    thread_local ThreadTrack* track = nullptr;
+    if (!track) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.tracks.push_back(std::make_unique<ThreadTrack>());
+        track = reg.tracks.back().get();
+        track->id = static_cast<int>(reg.tracks.size());
+    }
+    return *track;
+}
+
+// Chrome trace timestamps are microseconds, three decimals keep the nanoseconds
+void writeMicros(std::FILE* file, uint64_t nanoseconds) { std::fprintf(file, "%llu.%03llu", static_cast<unsigned long long>(nanoseconds / 1000), static_cast<unsigned long long>(nanoseconds % 1000)); }
+
+}  // namespace
+
+void detail::record(const char* name, uint64_t start, uint64_t end) {
+    if (!recording.load(std::memory_order_relaxed)) return;  // stopped while the zone was open
+    ThreadTrack& track = localTrack();
+    std::lock_guard<std::mutex> lock(track.mutex);
+    track.events.push_back({name, start, end});
+}
+
+void nameThread(const char* name) {
+    if constexpr (ENABLED) {
+        ThreadTrack& track = localTrack();
+        std::lock_guard<std::mutex> lock(track.mutex);
+        track.name = name;
+    }
+}
+
+void start() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (auto& track : reg.tracks) {
+        std::lock_guard<std::mutex> trackLock(track->mutex);
+        track->events.clear();
+    }
+    reg.origin = detail::now();
+    detail::recording.store(true);
+}
+
+bool stop(const std::string& path) {
+    detail::recording.store(false);
+
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) return false;
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", file);
+    bool first = true;
+    for (auto& track : reg.tracks) {
+        std::lock_guard<std::mutex> trackLock(track->mutex);
+        std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"", first ? "" : ",\n", track->id);
+        if (track->name) {
+            std::fputs(track->name, file);
+        } else {
+            std::fprintf(file, "thread %d", track->id);
+        }
+        std::fputs("\"}}", file);
+        first = false;
+
+        for (const Event& event : track->events) {
+            // events that began before start() are clipped to the recording
+            uint64_t begin = event.start > reg.origin ? event.start - reg.origin : 0;
+            uint64_t end = event.end > reg.origin ? event.end - reg.origin : 0;
+            std::fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":", event.name, track->id);
+            writeMicros(file, begin);
+            std::fputs(",\"dur\":", file);
+            writeMicros(file, end - begin);
+            std::fputc('}', file);
+        }
+    }
+    std::fputs("\n]}\n", file);
+    return std::fclose(file) == 0;
+}
+
+}  // namespace timeline
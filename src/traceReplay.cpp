@@ -0,0 +1,94 @@
+#include "traceReplay.hpp"
+
+#include <algorithm>
+
+#include "constants.hpp"
+#include "imgui.h"
+
+constexpr float MAX_STEPS_PER_SECOND = 100000.0f;
+constexpr float MAX_FRAME_SECONDS = 0.1f;  // the first frame after an idle stretch must not jump ahead
+
+void TraceReplay::start(const trace::Recorder& trace, const std::vector<std::vector<int>>& solved, const std::vector<std::vector<bool>>& solvedGivens) {
+    const int size = static_cast<int>(solved.size());
+    std::vector<uint8_t> endCells(size * size);
+    for (int row = 0; row < size; row++) {
+        for (int col = 0; col < size; col++) endCells[row * size + col] = static_cast<uint8_t>(solved[row][col]);
+    }
+
+    recorder = &trace;
+    startCells = trace::windowStart(trace, std::move(endCells));
+    grid.assign(size, std::vector<int>(size, EMPTY));
+    givens = solvedGivens;
+    playing = true;
+    rewind();
+}
+
+void TraceReplay::rewind() {
+    const int size = static_cast<int>(grid.size());
+    for (int row = 0; row < size; row++) {
+        for (int col = 0; col < size; col++) grid[row][col] = startCells[row * size + col];
+    }
+    position = 0;
+    lastCell = -1;
+    owed = 0.0;
+}
+
+void TraceReplay::advance(size_t steps) {
+    const int size = static_cast<int>(grid.size());
+    const size_t end = std::min(recorder->size(), position + steps);
+    for (; position < end; position++) {
+        const trace::Event event = (*recorder)[position];
+        grid[event.cell / size][event.cell % size] = event.action == trace::Action::Place ? event.digit : EMPTY;
+        lastCell = event.cell;
+        lastAction = event.action;
+    }
+}
+
+void TraceReplay::render() {
+    if (!recorder) return;
+    const size_t total = recorder->size();
+
+    if (ImGui::Button(playing ? "Pause###replayToggle" : "Play###replayToggle", ImVec2(80, 0))) {
+        if (!playing && position == total) rewind();
+        playing = !playing;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Step")) {
+        playing = false;
+        advance(1);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Restart")) rewind();
+    ImGui::SameLine();
+    if (ImGui::Button("End")) {
+        playing = false;
+        advance(total - position);
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(200.0f);
+    ImGui::SliderFloat("Steps / s", &stepsPerSecond, 1.0f, MAX_STEPS_PER_SECOND, "%.0f", ImGuiSliderFlags_Logarithmic);
+
+    if (playing) {
+        owed += stepsPerSecond * std::min(ImGui::GetIO().DeltaTime, MAX_FRAME_SECONDS);
+        size_t steps = static_cast<size_t>(owed);
+        owed -= static_cast<double>(steps);
+        advance(steps);
+        if (position == total) playing = false;
+    }
+
+    if (recorder->dropped() > 0) {
+        ImGui::Text("Step %zu / %zu (the search took %llu steps, only the last ones are kept)", position, total, static_cast<unsigned long long>(recorder->total()));
+    } else {
+        ImGui::Text("Step %zu / %zu", position, total);
+    }
+
+    const int size = static_cast<int>(grid.size());
+    for (int cell = 0; cell < size * size; cell++) {
+        uint8_t style = givens[cell / size][cell % size] ? CELL_GIVEN : CELL_NORMAL;
+        if (cell == lastCell) style = lastAction == trace::Action::Place ? CELL_SELECTED : CELL_INVALID;
+        styles[cell] = style;
+    }
+
+    int clickedRow, clickedCol;
+    drawBoard("##replayBoard", grid, styles.data(), clickedRow, clickedCol);
+}
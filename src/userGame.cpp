@@ -1,135 +1,97 @@
 #include "userGame.hpp"
 
-#include <string>
+#include <array>
 
-#include "backtracking.hpp"
+#include "boardWidget.hpp"
 #include "imgui.h"
 
 static int selectedRow = -1, selectedCol = -1;
 static int selectedValue = -1;
 
-bool isPuzzleSolved(std::vector<std::vector<int>>& grid) {
-    for (int i = 0; i < 9; i++) {
-        for (int j = 0; j < 9; j++) {
-            if (grid[i][j] == 0 || !backtracking::isValid(i, j, grid[i][j], grid)) {
-                return false;  
-            }
-        }
-    }
-    return true;
-}
-
-void renderPuzzleForUser(std::vector<std::vector<int>>& grid, const std::vector<std::vector<bool>>& givens, bool& puzzleSolved, float& elapsedTime) {
-    const float cellSize = 50.0f;
-    float totalWidth = cellSize * 9 + 6 * ImGui::GetStyle().ItemSpacing.x + 2 * 15.0f;
-    float windowWidth = ImGui::GetWindowWidth();
-
-    if (!puzzleSolved && isPuzzleSolved(grid)) {
-        puzzleSolved = true;
-        elapsedTime = ImGui::GetTime();
-    }
-
-    for (int i = 0; i < 9; i++) {
-        float posX = (windowWidth - totalWidth) * 0.5f;
-        ImGui::SetCursorPosX(posX);
-
-        for (int j = 0; j < 9; j++) {
-            std::string label = (grid[i][j] != 0 ? std::to_string(grid[i][j]) : " ") + "##" + std::to_string(i) + "_" + std::to_string(j);
-
-            bool isGiven = givens[i][j];
-            bool isSelected = (selectedRow == i && selectedCol == j);
-            bool isInvalid = false;
-
-            if (!puzzleSolved) {
-                if (!isGiven && grid[i][j] != 0) {
-                    int temp = grid[i][j];
-                    grid[i][j] = 0;
-                    isInvalid = !backtracking::isValid(i, j, temp, grid);
-                    grid[i][j] = temp;
+void renderPuzzleForUser(const std::vector<std::vector<int>>& grid, const std::vector<std::vector<bool>>& givens, const PlayerBoard& player) {
+    static std::array<uint8_t, MAX_BOARD_CELLS> styles;
+    // styles only change with the grid or the selection, idle frames just redraw them
+    static uint32_t stylesRevision = 0;
+    static int stylesRow = -1, stylesCol = -1;
+    static bool stylesValid = false;
+
+    const int size = static_cast<int>(grid.size());
+    const bool solved = player.solved();
+
+    if (!stylesValid || stylesRevision != player.revision() || stylesRow != selectedRow || stylesCol != selectedCol) {
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                bool isGiven = givens[i][j];
+                bool isSelected = (selectedRow == i && selectedCol == j);
+                bool isInvalid = !solved && !isGiven && player.conflicts(i, j, grid[i][j]);
+
+                uint8_t style = CELL_NORMAL;
+                if (solved || isGiven) {
+                    style = CELL_GIVEN;
+                } else if (isSelected && !isInvalid) {
+                    style = CELL_SELECTED;
+                } else if (isInvalid) {
+                    style = CELL_INVALID;
                 }
-            }
-
-            if (puzzleSolved || isGiven) {
-                ImGui::PushStyleColor(ImGuiCol_Button, RGBA(0, 191, 255, 0.8));  // Light Blue
-            } else if (isSelected && !isInvalid) {
-                ImGui::PushStyleColor(ImGuiCol_Button, RGBA(0, 84, 251, 0.8));  // Dark Blue
-            } else if (isInvalid) {
-                ImGui::PushStyleColor(ImGuiCol_Button, RGBA(255, 0, 0, 0.8));  // Red
-            }
-
-            if (ImGui::Button(label.c_str(), ImVec2(cellSize, cellSize))) {
-                selectedRow = i;
-                selectedCol = j;
-            }
-
-            if (isGiven || isSelected || isInvalid || puzzleSolved) {
-                ImGui::PopStyleColor();
-            }
-
-            if ((j + 1) % 3 == 0 && j < 8) {
-                ImGui::SameLine(0.0f, 15.0f);
-            } else if (j < 8) {
-                ImGui::SameLine();
+                styles[i * size + j] = style;
             }
         }
-
-        if ((i + 1) % 3 == 0 && i < 8) {
-            ImGui::Spacing();
-            ImGui::Spacing();
-        }
+        stylesRevision = player.revision();
+        stylesRow = selectedRow;
+        stylesCol = selectedCol;
+        stylesValid = true;
     }
 
-    if (puzzleSolved) {
-        ImGui::Spacing();
-        ImGui::Text("Puzzle Solved Successfully in %.2f seconds!", elapsedTime);
-    }
+    drawBoard("##userBoard", grid, styles.data(), selectedRow, selectedCol);
 }
 
-void renderInputGrid(std::vector<std::vector<int>>& grid, const std::vector<std::vector<bool>>& givens) {
+void renderInputGrid(std::vector<std::vector<int>>& grid, const std::vector<std::vector<bool>>& givens, PlayerBoard& player) {
     const float cellSize = 40.0f;
+    const int size = static_cast<int>(grid.size());
+    const int perRow = boxShapeOf(size).cols;  // digits laid out like one box
 
-    float totalWidth = (cellSize * 3) + (ImGui::GetStyle().ItemSpacing.x * 2);  // 3 cells per row + spacing
+    float totalWidth = (cellSize * perRow) + (ImGui::GetStyle().ItemSpacing.x * (perRow - 1));  // perRow cells per row + spacing
     float windowWidth = ImGui::GetWindowWidth();
     float posX = (windowWidth - totalWidth) * 0.5f;
 
-    for (int i = 1; i <= 9; i++) {
-        if (i % 3 == 1) {
+    for (int i = 1; i <= size; i++) {
+        if (i % perRow == 1) {
             ImGui::SetCursorPosX(posX);
         }
 
-        std::string label = std::to_string(i);
-        if (ImGui::Button(label.c_str(), ImVec2(cellSize, cellSize))) {
+        if (ImGui::Button(digitGlyph(i), ImVec2(cellSize, cellSize))) {
             if (selectedRow != -1 && selectedCol != -1 && givens[selectedRow][selectedCol] == 0) {
-                grid[selectedRow][selectedCol] = i;
+                player.place(grid, selectedRow, selectedCol, i);
                 selectedRow = -1;
                 selectedCol = -1;
             }
         }
 
-        if (i % 3 != 0) {
+        if (i % perRow != 0) {
             ImGui::SameLine();
         }
     }
 }
 
-void renderClearButton(std::vector<std::vector<int>>& grid) {
+void renderClearButton(std::vector<std::vector<int>>& grid, const std::vector<std::vector<bool>>& givens, PlayerBoard& player) {
     if (ImGui::Button("Clear Cell", ImVec2(150, 50))) {
-        if (selectedRow != -1 && selectedCol != -1) {
-            grid[selectedRow][selectedCol] = 0;
+        if (selectedRow != -1 && selectedCol != -1 && !givens[selectedRow][selectedCol]) {
+            player.place(grid, selectedRow, selectedCol, EMPTY);
         }
     }
     ImGui::SameLine();
 }
 
-void renderRestartButton(std::vector<std::vector<int>>& grid, const std::vector<std::vector<bool>>& givens) {
+void renderRestartButton(std::vector<std::vector<int>>& grid, const std::vector<std::vector<bool>>& givens, PlayerBoard& player) {
     if (ImGui::Button("Restart", ImVec2(100, 50))) {
-        for (int i = 0; i < SIZE; i++) {
-            for (int j = 0; j < SIZE; j++) {
+        for (int i = 0; i < static_cast<int>(grid.size()); i++) {
+            for (int j = 0; j < static_cast<int>(grid.size()); j++) {
                 if (givens[i][j] == false) {
                     grid[i][j] = 0;
                 }
             }
         }
+        player.reset(grid);
     }
     ImGui::SameLine();
 }
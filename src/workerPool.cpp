@@ -0,0 +1,48 @@
+#include "workerPool.hpp"
+
+#include <algorithm>
+
+#include "timeline.hpp"
+
+WorkerPool::WorkerPool(int threadCount) {
+    if (threadCount <= 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 0; i < threadCount; i++) {
+        threads.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (auto& thread : threads) {
+        if (thread.joinable()) thread.join();
+    }
+}
+
+void WorkerPool::submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+    }
+    available.notify_one();
+}
+
+void WorkerPool::workerLoop() {
+    timeline::nameThread("worker");
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true) {
+        available.wait(lock, [this]() { return stopping || !jobs.empty(); });
+        if (jobs.empty()) return;  // stopping and drained
+
+        std::function<void()> job = std::move(jobs.front());
+        jobs.pop_front();
+
+        lock.unlock();
+        job();
+        lock.lock();
+    }
+}